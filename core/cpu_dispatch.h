@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#ifndef SCIPP_CORE_CPU_DISPATCH_H
+#define SCIPP_CORE_CPU_DISPATCH_H
+
+/// Compile a function once per instruction set and select the best version
+/// supported by the CPU when the library is loaded.
+///
+/// The baseline build targets generic x86-64 (SSE2), so loops written without
+/// branches in the function body are vectorised with AVX-512 and AVX2 in the
+/// respective clones. This relies on GCC's `target_clones` and ifunc support
+/// on Linux. On other platforms only the baseline version is built.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) &&         \
+    defined(__linux__)
+#define SCIPP_CPU_DISPATCH                                                     \
+  __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define SCIPP_CPU_DISPATCH
+#endif
+
+#endif // SCIPP_CORE_CPU_DISPATCH_H
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#include <functional>
+#include <vector>
+
+#include "scipp/core/dataset.h"
+#include "scipp/core/except.h"
+#include "scipp/core/parallel.h"
+
+namespace scipp::core {
+
+namespace filter_events_detail {
+/// Indices of the events of a single event list that are kept.
+using Kept = std::vector<scipp::index>;
+/// Remove the events of the i-th event list of a variable that are not kept.
+using Compact = std::function<void(const scipp::index, const Kept &)>;
+
+/// Return the result of `op(T{})` for the type T matching `dtype`.
+template <class... Ts, class Op> auto invoke(const DType dtype, Op op) {
+  std::invoke_result_t<Op, double> ret;
+  if (!((core::dtype<Ts> == dtype ? (ret = op(Ts{}), true) : false) || ...))
+    throw except::TypeError("Unsupported dtype.");
+  return ret;
+}
+
+/// Return pointers to all elements of `view`, in iteration order.
+template <class View> auto pointers(View &&view) {
+  std::vector<decltype(&*view.begin())> out;
+  out.reserve(view.size());
+  for (auto &item : view)
+    out.push_back(&item);
+  return out;
+}
+
+template <class T> void compact(T &events, const Kept &kept) {
+  for (scipp::index k = 0; k < scipp::size(kept); ++k)
+    events[k] = events[kept[k]];
+  events.resize(kept.size());
+}
+
+/// Return a function compacting the event lists of the sparse `var`, including
+/// its variances.
+Compact make_compact(const VariableProxy &var) {
+  return invoke<double, float, int64_t, int32_t>(
+      var.dtype(), [&](const auto tag) -> Compact {
+        using T = std::decay_t<decltype(tag)>;
+        auto values = pointers(var.template sparseValues<T>());
+        if (!var.hasVariances())
+          return [values](const scipp::index i, const Kept &kept) {
+            compact(*values[i], kept);
+          };
+        auto variances = pointers(var.template sparseVariances<T>());
+        return [values, variances](const scipp::index i, const Kept &kept) {
+          compact(*values[i], kept);
+          compact(*variances[i], kept);
+        };
+      });
+}
+
+/// Return a function writing the indices of the events of the i-th event list
+/// of `coord` that lie in the interval [min, max).
+std::function<void(const scipp::index, Kept &)>
+make_select(const VariableConstProxy &coord, const VariableConstProxy &min,
+            const VariableConstProxy &max) {
+  return invoke<double, float, int64_t, int32_t>(
+      coord.dtype(),
+      [&](const auto tag) -> std::function<void(const scipp::index, Kept &)> {
+        using T = std::decay_t<decltype(tag)>;
+        return [events = pointers(coord.template sparseValues<T>()),
+                low = min.template value<T>(), high = max.template value<T>()](
+                   const scipp::index i, Kept &kept) {
+          const auto &list = *events[i];
+          kept.clear();
+          for (scipp::index j = 0; j < scipp::size(list); ++j)
+            if (list[j] >= low && list[j] < high)
+              kept.push_back(j);
+        };
+      });
+}
+} // namespace filter_events_detail
+
+/// Remove all events of `sparse` with a sparse coord for `dim` outside the
+/// interval [min, max).
+///
+/// The sparse coord, the data, and all sparse labels are compacted in place,
+/// processing event lists in parallel. `min` and `max` must be scalars with the
+/// dtype and unit of the coord.
+void filter_events(const DataProxy &sparse, const Dim dim,
+                   const VariableConstProxy &min,
+                   const VariableConstProxy &max) {
+  using namespace filter_events_detail;
+  if (!sparse.dims().sparse() || sparse.dims().sparseDim() != dim)
+    throw except::DimensionError("Expected data that is sparse in " +
+                                 to_string(dim) + '.');
+  const auto coord = sparse.coords()[dim];
+  for (const auto &bound : {min, max}) {
+    expect::equals(bound.dims(), Dimensions());
+    expect::unit(bound, coord.unit());
+  }
+
+  std::vector<Compact> fields{make_compact(coord)};
+  const auto add = [&](const VariableProxy &var) {
+    expect::equals(var.dims(), coord.dims());
+    fields.push_back(make_compact(var));
+  };
+  if (sparse.hasData())
+    add(sparse.data());
+  for (const auto &item : sparse.labels())
+    if (item.second.dims().sparse())
+      add(item.second);
+  // Mutable access above may have copied shared buffers, select afterwards.
+  const auto select = make_select(coord, min, max);
+
+  parallel::parallel_for(
+      parallel::blocked_range(0, sparse.dims().volume()),
+      [&](const auto &range) {
+        Kept kept;
+        for (auto i = range.begin(); i < range.end(); ++i) {
+          select(i, kept);
+          for (const auto &field : fields)
+            field(i, kept);
+        }
+      });
+}
+
+/// Remove all events of all items of `dataset` that are sparse in `dim` with a
+/// sparse coord outside the interval [min, max).
+void filter_events(Dataset &dataset, const Dim dim,
+                   const VariableConstProxy &min,
+                   const VariableConstProxy &max) {
+  for (const auto &item : dataset)
+    if (item.dims().sparse() && item.dims().sparseDim() == dim)
+      filter_events(item, dim, min, max);
+}
+
+} // namespace scipp::core
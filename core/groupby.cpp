@@ -2,12 +2,17 @@
 // Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
 /// @file
 /// @author Simon Heybrock
+#include <algorithm>
+#include <functional>
 #include <numeric>
+#include <optional>
 
+#include "scipp/common/overloaded.h"
 #include "scipp/core/except.h"
 #include "scipp/core/groupby.h"
 #include "scipp/core/histogram.h"
 #include "scipp/core/indexed_slice_view.h"
+#include "scipp/core/parallel.h"
 #include "scipp/core/tag_util.h"
 
 #include "dataset_operations_common.h"
@@ -28,23 +33,143 @@ T GroupBy<T>::makeReductionOutput(const Dim reductionDim) const {
   return out;
 }
 
+namespace groupby_detail {
+/// Upper limit for the number of partial results of a fused reduction if
+/// parallel::deterministic_reductions() is enabled.
+static constexpr scipp::index max_partials = 64;
+
+/// Return the index of the group of each row along the reduction dimension, or
+/// -1 for rows that are not part of any group.
+std::vector<scipp::index>
+make_group_of_row(const std::vector<GroupByGrouping::group> &groups,
+                  const scipp::index rows) {
+  std::vector<scipp::index> group_of_row(rows, -1);
+  for (scipp::index group = 0; group < scipp::size(groups); ++group)
+    for (const auto &slice : groups[group])
+      std::fill(group_of_row.begin() + slice.begin(),
+                group_of_row.begin() + slice.end(), group);
+  return group_of_row;
+}
+
+/// Sum rows of `data` into the groups of `out` in a single pass.
+///
+/// The input is split into chunks of rows that are summed into separate
+/// partial results, which are combined in a fixed order.
+template <class V>
+void sum_rows(const VariableProxy &out, const VariableConstProxy &data,
+              const std::vector<scipp::index> &group_of_row,
+              const Dim reductionDim, const Variable &mask) {
+  const auto &dims = data.dims();
+  const auto rows = dims[reductionDim];
+  const auto inner = dims.offset(reductionDim);
+  const auto lines = dims.volume() / inner;
+  const auto n_groups = out.dims()[out.dims().label(dims.index(reductionDim))];
+  const auto out_volume = (lines / rows) * n_groups * inner;
+  const bool masked = mask.dims().contains(reductionDim);
+  const auto keep = masked ? mask.values<bool>() : scipp::span<const bool>{};
+
+  const auto accumulate = [&](std::vector<V> &sum, const auto &in,
+                              const scipp::index begin,
+                              const scipp::index end) {
+    auto it = in.begin() + begin * inner;
+    for (auto line = begin; line < end; ++line) {
+      const auto row = line % rows;
+      const auto group = group_of_row[row];
+      if (group < 0) {
+        it += inner;
+        continue;
+      }
+      // Masked rows are multiplied by zero, as in the per-group reduction.
+      const V scale = masked ? static_cast<V>(keep[row]) : V{1};
+      auto *out_line = sum.data() + ((line / rows) * n_groups + group) * inner;
+      for (scipp::index i = 0; i < inner; ++i, ++it)
+        out_line[i] += masked ? *it * scale : *it;
+    }
+  };
+
+  // Chunks contain at least as many elements as `out` to bound the memory used
+  // for partial results as well as the cost of combining them.
+  const auto grainsize =
+      std::max(scipp::index{1},
+               std::max(parallel::grainsize(), out_volume) / inner);
+  const parallel::blocked_range range(0, lines, grainsize);
+  const auto n = parallel::deterministic_reductions()
+                     ? std::clamp(lines / grainsize, scipp::index{1},
+                                  max_partials)
+                     : parallel::detail::chunk_count(range);
+  const auto reduce = [&](const auto &in, const auto &out_values) {
+    std::vector<std::vector<V>> partials(n, std::vector<V>(out_volume));
+    parallel::parallel_for(parallel::blocked_range(0, n), [&](const auto &r) {
+      for (auto i = r.begin(); i < r.end(); ++i)
+        accumulate(partials[i], in, lines * i / n, lines * (i + 1) / n);
+    });
+    for (scipp::index i = 1; i < n; ++i)
+      std::transform(partials[0].begin(), partials[0].end(),
+                     partials[i].begin(), partials[0].begin(), std::plus<V>());
+    std::copy(partials[0].begin(), partials[0].end(), out_values.begin());
+  };
+  reduce(data.values<V>(), out.values<V>());
+  if (data.hasVariances())
+    reduce(data.variances<V>(), out.variances<V>());
+}
+
+/// Return true if all groups of `data` can be summed into `out` by sum_rows.
+bool can_sum_rows(const VariableProxy &out, const VariableConstProxy &data,
+                  const Dim reductionDim, const Variable &mask) {
+  const auto &dims = data.dims();
+  if (dims.sparse() || !dims.contains(reductionDim) || dims.volume() == 0)
+    return false;
+  if (out.dtype() != data.dtype() || out.hasVariances() != data.hasVariances())
+    return false;
+  if (mask.dims().contains(reductionDim) && mask.dims().ndim() != 1)
+    return false;
+  // `out` must have the layout of `data` with the reduction dimension replaced
+  // by the group dimension.
+  if (out.dims().ndim() != dims.ndim())
+    return false;
+  const auto axis = dims.index(reductionDim);
+  auto expected = dims;
+  expected.resize(axis, out.dims().size(axis));
+  expected.relabel(axis, out.dims().label(axis));
+  return out.dims() == expected;
+}
+} // namespace groupby_detail
+
 template <class T>
 template <class Op>
 T GroupBy<T>::reduce(Op op, const Dim reductionDim) const {
   auto out = makeReductionOutput(reductionDim);
   const auto mask = ~masks_merge_if_contains(m_data.masks(), reductionDim);
-  // Apply to each group, storing result in output slice
-  for (scipp::index group = 0; group < size(); ++group) {
-    const auto out_slice = out.slice({dim(), group});
-    if constexpr (std::is_same_v<T, Dataset>) {
-      for (const auto &item : m_data) {
-        const auto out_data = out_slice[item.name()].data();
-        op(out_data, item, groups()[group], reductionDim, mask);
+  std::vector<scipp::index> group_of_row;
+  const auto apply = [&](const VariableProxy &out_data, const auto &data) {
+    // Ops providing a fused kernel reduce all groups in a single pass, given
+    // the group of each row.
+    if constexpr (std::is_invocable_r_v<bool, Op, const VariableProxy &,
+                                        const VariableConstProxy &,
+                                        const std::vector<scipp::index> &,
+                                        const Dim, const Variable &>) {
+      if (data.dims().contains(reductionDim)) {
+        if (group_of_row.empty())
+          group_of_row = groupby_detail::make_group_of_row(
+              groups(), data.dims()[reductionDim]);
+        if (op(out_data, data.data(), group_of_row, reductionDim, mask))
+          return;
       }
-    } else {
-      const auto out_data = out_slice.data();
-      op(out_data, m_data, groups()[group], reductionDim, mask);
     }
+    // Apply to each group, storing result in output slice. Output slices of
+    // different groups are disjoint so groups can be processed in parallel.
+    parallel::parallel_for(
+        parallel::blocked_range(0, size()), [&](const auto &range) {
+          for (auto group = range.begin(); group < range.end(); ++group)
+            op(out_data.slice({dim(), group}), data, groups()[group],
+               reductionDim, mask);
+        });
+  };
+  if constexpr (std::is_same_v<T, Dataset>) {
+    for (const auto &item : m_data)
+      apply(out[item.name()].data(), item);
+  } else {
+    apply(out.data(), m_data);
   }
   return out;
 }
@@ -70,32 +195,58 @@ template <class T> T GroupBy<T>::flatten(const Dim reductionDim) const {
       }
     }
   };
-  // Apply to each group, storing result in output slice
-  for (scipp::index group = 0; group < size(); ++group) {
-    const auto out_slice = out.slice({dim(), group});
-    if constexpr (std::is_same_v<T, Dataset>) {
-      for (const auto &item : m_data)
-        apply(out_slice[item.name()], item, group);
-    } else {
-      apply(out_slice, m_data, group);
-    }
-  }
+  // Apply to each group, storing result in output slice. Output slices of
+  // different groups are disjoint so groups can be processed in parallel.
+  parallel::parallel_for(
+      parallel::blocked_range(0, size()), [&](const auto &range) {
+        for (auto group = range.begin(); group < range.end(); ++group) {
+          const auto out_slice = out.slice({dim(), group});
+          if constexpr (std::is_same_v<T, Dataset>) {
+            for (const auto &item : m_data)
+              apply(out_slice[item.name()], item, group);
+          } else {
+            apply(out_slice, m_data, group);
+          }
+        }
+      });
   return out;
 }
 
 namespace groupby_detail {
-static constexpr auto sum = [](const VariableProxy &out_data,
-                               const auto &data_container,
-                               const GroupByGrouping::group &group,
-                               const Dim reductionDim, const Variable &mask) {
-  for (const auto &slice : group) {
-    const auto data_slice = data_container.slice(slice);
-    if (mask.dims().contains(reductionDim))
-      sum_impl(out_data, data_slice.data() * mask.slice(slice));
-    else
-      sum_impl(out_data, data_slice.data());
-  }
-};
+static constexpr auto sum = overloaded{
+    [](const VariableProxy &out_data, const auto &data_container,
+       const GroupByGrouping::group &group, const Dim reductionDim,
+       const Variable &mask) {
+      for (const auto &slice : group) {
+        const auto data_slice = data_container.slice(slice);
+        if (mask.dims().contains(reductionDim))
+          sum_impl(out_data, data_slice.data() * mask.slice(slice));
+        else
+          sum_impl(out_data, data_slice.data());
+      }
+    },
+    [](const VariableProxy &out_data, const VariableConstProxy &data,
+       const std::vector<scipp::index> &group_of_row, const Dim reductionDim,
+       const Variable &mask) {
+      if (!can_sum_rows(out_data, data, reductionDim, mask))
+        return false;
+      switch (data.dtype()) {
+      case dtype<double>:
+        sum_rows<double>(out_data, data, group_of_row, reductionDim, mask);
+        return true;
+      case dtype<float>:
+        sum_rows<float>(out_data, data, group_of_row, reductionDim, mask);
+        return true;
+      case dtype<int64_t>:
+        sum_rows<int64_t>(out_data, data, group_of_row, reductionDim, mask);
+        return true;
+      case dtype<int32_t>:
+        sum_rows<int32_t>(out_data, data, group_of_row, reductionDim, mask);
+        return true;
+      default:
+        return false;
+      }
+    }};
 
 template <void (*Func)(const VariableProxy &, const VariableConstProxy &)>
 static constexpr auto reduce_idempotent =
@@ -189,35 +340,181 @@ static void expectValidGroupbyKey(const VariableConstProxy &key) {
     throw except::VariancesError("Group-by key cannot have variances");
 }
 
+namespace groupby_detail {
+/// Integer keys spanning at most this many values plus the number of runs are
+/// grouped using an array indexed by the key.
+static constexpr scipp::index max_dense_slack = 65536;
+
+/// Ranges [begin, end) of consecutive equal values.
+template <class Values> auto find_runs(const Values &values) {
+  std::vector<std::pair<scipp::index, scipp::index>> runs;
+  const auto size = scipp::size(values);
+  for (scipp::index i = 0; i < size;) {
+    // Use contiguous (thick) slices if possible to avoid overhead of slice
+    // handling in follow-up "apply" steps.
+    const auto begin = i;
+    const auto &value = values[i];
+    while (i < size && values[i] == value)
+      ++i;
+    runs.emplace_back(begin, i);
+  }
+  return runs;
+}
+
+/// Return the key of `value`, mapping -0.0 to 0.0 since they compare equal.
+template <class T> T normalize(const T &value) {
+  if constexpr (std::is_floating_point_v<T>)
+    return value == T{0} ? T{0} : value;
+  else
+    return value;
+}
+
+/// Result of grouping runs: The sorted distinct keys and the index of the key
+/// for each run.
+template <class T> struct Grouping {
+  std::vector<T> keys;
+  std::vector<scipp::index> group_of_run;
+};
+
+/// Group runs of integer keys with a small range using an array indexed by key.
+template <class T>
+std::optional<Grouping<T>> group_dense(const std::vector<T> &run_keys) {
+  if constexpr (std::is_integral_v<T>) {
+    const auto [min, max] =
+        std::minmax_element(run_keys.begin(), run_keys.end());
+    const auto range = static_cast<double>(*max) - *min + 1;
+    if (range > scipp::size(run_keys) + max_dense_slack)
+      return std::nullopt;
+    std::vector<scipp::index> index(static_cast<scipp::index>(range), -1);
+    for (const auto &key : run_keys)
+      index[key - *min] = 0;
+    Grouping<T> out;
+    for (scipp::index i = 0; i < scipp::size(index); ++i)
+      if (index[i] == 0) {
+        index[i] = scipp::size(out.keys);
+        out.keys.push_back(static_cast<T>(*min + i));
+      }
+    out.group_of_run.reserve(run_keys.size());
+    for (const auto &key : run_keys)
+      out.group_of_run.push_back(index[key - *min]);
+    return out;
+  } else {
+    static_cast<void>(run_keys);
+    return std::nullopt;
+  }
+}
+
+/// Group runs with an open-addressing hash table, for low cardinality.
+///
+/// Returns std::nullopt if the number of distinct keys exceeds half the number
+/// of runs, in which case sorting is cheaper.
+template <class T>
+std::optional<Grouping<T>> group_hashed(const std::vector<T> &run_keys) {
+  const auto max_groups = scipp::size(run_keys) / 2 + 1;
+  std::vector<T> keys;
+  std::vector<scipp::index> slots(16, -1);
+  std::vector<scipp::index> group_of_run;
+  group_of_run.reserve(run_keys.size());
+  const auto slot = [&slots](const T &key) {
+    // Fibonacci hashing spreads consecutive integers over the table.
+    return (std::hash<T>{}(key)*11400714819323198485ull) % slots.size();
+  };
+  const auto insert = [&](const T &key) {
+    auto i = slot(key);
+    while (slots[i] >= 0 && !(keys[slots[i]] == key))
+      i = (i + 1) % slots.size();
+    if (slots[i] < 0) {
+      slots[i] = scipp::size(keys);
+      keys.push_back(key);
+    }
+    return slots[i];
+  };
+  for (const auto &key : run_keys) {
+    group_of_run.push_back(insert(key));
+    if (scipp::size(keys) > max_groups)
+      return std::nullopt;
+    if (2 * keys.size() > slots.size()) {
+      slots.assign(2 * slots.size(), -1);
+      for (scipp::index i = 0; i < scipp::size(keys); ++i) {
+        auto j = slot(keys[i]);
+        while (slots[j] >= 0)
+          j = (j + 1) % slots.size();
+        slots[j] = i;
+      }
+    }
+  }
+  // Groups were numbered in order of appearance, renumber in key order.
+  std::vector<scipp::index> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&keys](const auto i, const auto j) {
+    return keys[i] < keys[j];
+  });
+  std::vector<scipp::index> rank(keys.size());
+  Grouping<T> out;
+  for (scipp::index i = 0; i < scipp::size(order); ++i) {
+    rank[order[i]] = i;
+    out.keys.push_back(std::move(keys[order[i]]));
+  }
+  for (auto &group : group_of_run)
+    group = rank[group];
+  out.group_of_run = std::move(group_of_run);
+  return out;
+}
+
+/// Group runs by sorting them by key, for high cardinality.
+template <class T> Grouping<T> group_sorted(const std::vector<T> &run_keys) {
+  std::vector<scipp::index> order(run_keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&run_keys](const auto i, const auto j) {
+                     return run_keys[i] < run_keys[j];
+                   });
+  Grouping<T> out;
+  out.group_of_run.resize(run_keys.size());
+  for (const auto i : order) {
+    if (out.keys.empty() || out.keys.back() < run_keys[i])
+      out.keys.push_back(run_keys[i]);
+    out.group_of_run[i] = scipp::size(out.keys) - 1;
+  }
+  return out;
+}
+
+/// Return the sorted distinct keys and the group index of every run.
+///
+/// Uses a dense array for integer keys with a small range, such as spectrum
+/// numbers, a hash table if there are few distinct keys, and sorting
+/// otherwise.
+template <class T> Grouping<T> group(const std::vector<T> &run_keys) {
+  if (auto grouping = group_dense(run_keys))
+    return std::move(*grouping);
+  if (auto grouping = group_hashed(run_keys))
+    return std::move(*grouping);
+  return group_sorted(run_keys);
+}
+} // namespace groupby_detail
+
 template <class T> struct MakeGroups {
   static auto apply(const VariableConstProxy &key, const Dim targetDim) {
+    using namespace groupby_detail;
     expectValidGroupbyKey(key);
     const auto &values = key.values<T>();
 
     const auto dim = key.dims().inner();
-    std::map<T, GroupByGrouping::group> indices;
-    const auto end = values.end();
-    scipp::index i = 0;
-    for (auto it = values.begin(); it != end;) {
-      // Use contiguous (thick) slices if possible to avoid overhead of slice
-      // handling in follow-up "apply" steps.
-      const auto begin = i;
-      const auto &value = *it;
-      while (it != end && *it == value) {
-        ++it;
-        ++i;
-      }
-      indices[value].emplace_back(dim, begin, i);
-    }
+    const auto runs = find_runs(values);
+    std::vector<T> run_keys;
+    run_keys.reserve(runs.size());
+    for (const auto &run : runs)
+      run_keys.push_back(normalize<T>(values[run.first]));
+    auto grouping = group(run_keys);
 
-    const Dimensions dims{targetDim, scipp::size(indices)};
-    std::vector<T> keys;
-    std::vector<GroupByGrouping::group> groups;
-    for (auto &item : indices) {
-      keys.emplace_back(std::move(item.first));
-      groups.emplace_back(std::move(item.second));
-    }
-    auto keys_ = makeVariable<T>(Dimensions{dims}, Values(std::move(keys)));
+    std::vector<GroupByGrouping::group> groups(grouping.keys.size());
+    for (scipp::index i = 0; i < scipp::size(runs); ++i)
+      groups[grouping.group_of_run[i]].emplace_back(dim, runs[i].first,
+                                                    runs[i].second);
+
+    const Dimensions dims{targetDim, scipp::size(groups)};
+    auto keys_ =
+        makeVariable<T>(Dimensions{dims}, Values(std::move(grouping.keys)));
     keys_.setUnit(key.unit());
     return GroupByGrouping{std::move(keys_), std::move(groups)};
   }
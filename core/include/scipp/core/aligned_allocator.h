@@ -21,11 +21,6 @@ enum class Alignment : size_t {
 };
 
 namespace detail {
-void *allocate_aligned_memory(size_t align, size_t size);
-void deallocate_aligned_memory(void *ptr) noexcept;
-
-//#define USE_POOL
-
 template <typename T> constexpr bool is_power_of_two(T v) {
   return v && ((v & (v - 1)) == 0);
 }
@@ -33,33 +28,17 @@ template <typename T> constexpr bool is_power_of_two(T v) {
 inline void *allocate_aligned_memory(size_t align, size_t size) {
   assert(align >= sizeof(void *));
   assert(is_power_of_two(align));
+  assert(align <= MemoryPool::alignment);
 
   if (size == 0) {
     return nullptr;
   }
 
-#ifdef USE_POOL
-  return instance().allocate(size);
-#else
-  void *ptr = nullptr;
-  int rc = posix_memalign(&ptr, align, size);
-  if (rc != 0) {
-    return nullptr;
-  }
-  return ptr;
-#endif
+  return pool_allocate(size);
 }
 
-inline void deallocate_aligned_memory(void *ptr) noexcept {
-#ifdef USE_POOL
-  return instance().deallocate(ptr);
-#else
-#ifdef _WIN32
-  return _aligned_free(ptr);
-#else
-  return free(ptr);
-#endif
-#endif
+inline void deallocate_aligned_memory(void *ptr, size_t size) noexcept {
+  return pool_deallocate(ptr, size);
 }
 } // namespace detail
 
@@ -119,8 +98,8 @@ public:
     return reinterpret_cast<pointer>(ptr);
   }
 
-  void deallocate(pointer p, size_type) noexcept {
-    return detail::deallocate_aligned_memory(p);
+  void deallocate(pointer p, size_type n) noexcept {
+    return detail::deallocate_aligned_memory(p, n * sizeof(T));
   }
 
   template <class U, class... Args> void construct(U *p, Args &&... args) {
@@ -171,8 +150,8 @@ public:
     return reinterpret_cast<pointer>(ptr);
   }
 
-  void deallocate(pointer p, size_type) noexcept {
-    return detail::deallocate_aligned_memory(p);
+  void deallocate(pointer p, size_type n) noexcept {
+    return detail::deallocate_aligned_memory(p, n * sizeof(T));
   }
 
   template <class U, class... Args> void construct(U *p, Args &&... args) {
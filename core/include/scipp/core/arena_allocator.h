@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#ifndef SCIPP_CORE_ARENA_ALLOCATOR_H
+#define SCIPP_CORE_ARENA_ALLOCATOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include <boost/intrusive_ptr.hpp>
+
+namespace scipp::core {
+
+namespace detail {
+/// Thread-safe bump allocator, releasing all memory at once when destroyed.
+///
+/// Memory is obtained in chunks of geometrically growing size. Deallocation is
+/// a no-op, i.e., memory of a block is only reclaimed once the arena is
+/// destroyed. Blocks left behind when a container grows are thus kept, which is
+/// bounded by the geometric growth of the container. The arena is reference
+/// counted and destroyed when the last allocator referencing it is gone.
+class Arena {
+public:
+  static constexpr std::size_t min_chunk_size = 4096;
+  static constexpr std::size_t max_chunk_size = 16 * 1024 * 1024;
+
+  Arena() = default;
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  void *allocate(const std::size_t bytes, const std::size_t align) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto offset = (m_used + align - 1) / align * align;
+    if (offset + bytes > m_capacity) {
+      // Chunks are allocated with new and are thus aligned for any fundamental
+      // type, so the new block starts at offset 0.
+      m_capacity = std::max(bytes, std::min(2 * m_capacity, max_chunk_size));
+      m_capacity = std::max(m_capacity, min_chunk_size);
+      m_chunks.emplace_back(new std::byte[m_capacity]);
+      m_reserved += m_capacity;
+      offset = 0;
+    }
+    m_used = offset + bytes;
+    return m_chunks.back().get() + offset;
+  }
+
+  void deallocate(void *, const std::size_t) noexcept {}
+
+  /// Return the total size of all chunks.
+  std::size_t reserved() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_reserved;
+  }
+
+  friend void intrusive_ptr_add_ref(Arena *arena) noexcept {
+    arena->m_count.fetch_add(1, std::memory_order_relaxed);
+  }
+  friend void intrusive_ptr_release(Arena *arena) noexcept {
+    if (arena->m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      delete arena;
+  }
+
+private:
+  mutable std::mutex m_mutex;
+  std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+  std::size_t m_capacity{0};
+  std::size_t m_used{0};
+  std::size_t m_reserved{0};
+  std::atomic<std::size_t> m_count{0};
+};
+} // namespace detail
+
+/// Allocator for the event lists in sparse variables.
+///
+/// A default-constructed allocator uses the heap. An allocator constructed from
+/// an arena draws memory from that arena. element_array attaches a common arena
+/// to all its elements, such that constructing and destroying a sparse
+/// variable does not require one heap allocation per event list. Copies of
+/// containers use the heap, unless they are assigned to a container that is
+/// attached to an arena.
+template <class T> class arena_allocator {
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  arena_allocator() noexcept = default;
+  explicit arena_allocator(boost::intrusive_ptr<detail::Arena> arena) noexcept
+      : m_arena(std::move(arena)) {}
+  template <class U>
+  arena_allocator(const arena_allocator<U> &other) noexcept
+      : m_arena(other.arena()) {}
+
+  T *allocate(const std::size_t n) {
+    if (!m_arena)
+      return std::allocator<T>{}.allocate(n);
+    return static_cast<T *>(m_arena->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *p, const std::size_t n) noexcept {
+    if (!m_arena)
+      std::allocator<T>{}.deallocate(p, n);
+    else
+      m_arena->deallocate(p, n * sizeof(T));
+  }
+
+  arena_allocator select_on_container_copy_construction() const noexcept {
+    return {};
+  }
+
+  const boost::intrusive_ptr<detail::Arena> &arena() const noexcept {
+    return m_arena;
+  }
+
+private:
+  boost::intrusive_ptr<detail::Arena> m_arena;
+};
+
+template <class T, class U>
+bool operator==(const arena_allocator<T> &a,
+                const arena_allocator<U> &b) noexcept {
+  return a.arena() == b.arena();
+}
+template <class T, class U>
+bool operator!=(const arena_allocator<T> &a,
+                const arena_allocator<U> &b) noexcept {
+  return !(a == b);
+}
+
+namespace detail {
+template <class T, class = void> struct uses_arena : std::false_type {};
+template <class T>
+struct uses_arena<
+    T, std::void_t<decltype(std::declval<T &>().get_allocator().arena())>>
+    : std::true_type {};
+/// True if T is a container using arena_allocator.
+template <class T> inline constexpr bool uses_arena_v = uses_arena<T>::value;
+} // namespace detail
+
+} // namespace scipp::core
+
+#endif // SCIPP_CORE_ARENA_ALLOCATOR_H
@@ -1418,6 +1418,13 @@ SCIPP_CORE_EXPORT Dataset histogram(const Dataset &dataset,
                                     const Variable &bins);
 SCIPP_CORE_EXPORT Dataset histogram(const Dataset &dataset, const Dim &dim);
 
+SCIPP_CORE_EXPORT void filter_events(const DataProxy &sparse, const Dim dim,
+                                     const VariableConstProxy &min,
+                                     const VariableConstProxy &max);
+SCIPP_CORE_EXPORT void filter_events(Dataset &dataset, const Dim dim,
+                                     const VariableConstProxy &min,
+                                     const VariableConstProxy &max);
+
 SCIPP_CORE_EXPORT Dataset merge(const DatasetConstProxy &a,
                                 const DatasetConstProxy &b);
 
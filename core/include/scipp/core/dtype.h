@@ -8,6 +8,8 @@
 #include <Eigen/Dense>
 #include <boost/container/small_vector.hpp>
 
+#include "scipp/core/arena_allocator.h"
+
 namespace scipp::python {
 class PyObject;
 }
@@ -18,7 +20,8 @@ class DataArray;
 class Dataset;
 
 template <class T>
-using sparse_container = boost::container::small_vector<T, 8>;
+using sparse_container =
+    boost::container::small_vector<T, 8, arena_allocator<T>>;
 
 template <class T> struct is_sparse : std::false_type {};
 template <class T> struct is_sparse<sparse_container<T>> : std::true_type {};
@@ -9,12 +9,48 @@
 #include <memory>
 
 #include "scipp/common/index.h"
+#include "scipp/core/arena_allocator.h"
+#include "scipp/core/memory_pool.h"
 
 namespace scipp::core::detail {
 
-/// Replacement for C++20 std::make_unique_default_init
-template <class T> auto make_unique_default_init(const scipp::index size) {
-  return std::unique_ptr<T>(new std::remove_extent_t<T>[size]);
+/// Deleter for arrays allocated from the memory pool.
+///
+/// If `owner` is set the array is an external buffer, which is released by
+/// resetting the owner instead.
+template <class T> struct pool_array_deleter {
+  scipp::index size{0};
+  std::shared_ptr<void> owner{};
+  void operator()(T *data) noexcept {
+    if (owner) {
+      owner.reset();
+      return;
+    }
+    std::destroy_n(data, size);
+    pool_deallocate(data, size * sizeof(T));
+  }
+};
+
+template <class T>
+using pool_array = std::unique_ptr<T[], pool_array_deleter<T>>;
+
+/// Allocate an array from the memory pool of the calling thread, with value-
+/// or default-initialized elements.
+template <class T>
+pool_array<T> make_pool_array(const scipp::index size,
+                              const bool default_init) {
+  static_assert(alignof(T) <= MemoryPool::alignment);
+  auto *data = static_cast<T *>(pool_allocate(size * sizeof(T)));
+  try {
+    if (default_init)
+      std::uninitialized_default_construct_n(data, size);
+    else
+      std::uninitialized_value_construct_n(data, size);
+  } catch (...) {
+    pool_deallocate(data, size * sizeof(T));
+    throw;
+  }
+  return pool_array<T>(data, pool_array_deleter<T>{size});
 }
 
 /// Tag for requesting default-initialization in methods of class element_array.
@@ -33,6 +69,10 @@ static constexpr auto default_init_elements = default_init_elements_t{};
 /// - As a minor benefit, since the implementation has to store a pointer and a
 ///   size, we can at the same time support an "optional" behavior, as used for
 ///   the array of variances in a variable.
+/// - Allocation from MemoryPool, so temporaries can reuse recently freed
+///   buffers, or referencing an external buffer such as a numpy array.
+/// - Elements that are containers using arena_allocator (event lists of sparse
+///   data) share a common arena, avoiding one heap allocation per element.
 template <class T> class element_array {
 public:
   using value_type = T;
@@ -65,6 +105,14 @@ public:
   explicit element_array(const Container &c)
       : element_array(c.begin(), c.end()) {}
 
+  /// Construct referencing an external buffer of `size` elements, which is
+  /// kept alive by `owner` until it is no longer referenced by the array.
+  element_array(T *data, const scipp::index size, std::shared_ptr<void> owner)
+      : m_size(size),
+        m_data(data, pool_array_deleter<T>{size, std::move(owner)}) {
+    static_assert(std::is_trivially_destructible_v<T>);
+  }
+
   element_array(std::initializer_list<T> init)
       : element_array(init.begin(), init.end()) {}
 
@@ -111,8 +159,9 @@ public:
       m_data.reset();
       m_size = 0;
     } else {
-      m_data = std::make_unique<T[]>(new_size);
+      m_data = make_pool_array<T>(new_size, false);
       m_size = new_size;
+      attach_arena();
     }
   }
 
@@ -122,12 +171,23 @@ public:
       m_data.reset();
       m_size = 0;
     } else if (new_size != size()) {
-      m_data = make_unique_default_init<T[]>(new_size);
+      m_data = make_pool_array<T>(new_size, true);
       m_size = new_size;
+      attach_arena();
     }
   }
 
 private:
+  /// Make all (empty) elements allocate from a new common arena.
+  void attach_arena() {
+    if constexpr (uses_arena_v<T>) {
+      const typename T::allocator_type alloc(
+          arena_allocator<typename T::value_type>(
+              boost::intrusive_ptr<Arena>(new Arena)));
+      for (scipp::index i = 0; i < size(); ++i)
+        m_data[i] = T(alloc);
+    }
+  }
   element_array from_other(const element_array &other) {
     if (other.size() == -1) {
       return element_array();
@@ -138,7 +198,7 @@ private:
     }
   }
   scipp::index m_size{-1};
-  std::unique_ptr<T[]> m_data;
+  pool_array<T> m_data;
 };
 
 } // namespace scipp::core::detail
@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#ifndef SCIPP_CORE_EXPRESSION_H
+#define SCIPP_CORE_EXPRESSION_H
+
+#include <cmath>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "scipp/core/transform.h"
+#include "scipp/core/variable.h"
+
+namespace scipp::core {
+
+namespace expression_detail {
+/// Input of an expression. Like a proxy, this does not own the referenced data.
+struct Leaf {
+  VariableConstProxy var;
+};
+
+/// Elementwise operation applied to the results of the child expressions.
+template <class Op, class... Args> struct Node {
+  std::tuple<Args...> args;
+};
+
+template <class E> struct leaf_count : std::integral_constant<std::size_t, 1> {};
+template <class Op, class... Args>
+struct leaf_count<Node<Op, Args...>>
+    : std::integral_constant<std::size_t, (leaf_count<Args>::value + ...)> {};
+
+/// Evaluate the expression E for the arguments in `x`, which correspond to the
+/// leaves of E starting at `Offset`.
+///
+/// The arguments can be elements, units, or variables. The latter is used for
+/// eager evaluation, so the ops below must support all of these.
+template <class E, std::size_t Offset> struct evaluate {
+  template <class Tuple> static decltype(auto) apply(const Tuple &x) {
+    return std::get<Offset>(x);
+  }
+};
+template <class Op, class A, std::size_t Offset>
+struct evaluate<Node<Op, A>, Offset> {
+  template <class Tuple> static auto apply(const Tuple &x) {
+    return Op{}(evaluate<A, Offset>::apply(x));
+  }
+};
+template <class Op, class A, class B, std::size_t Offset>
+struct evaluate<Node<Op, A, B>, Offset> {
+  template <class Tuple> static auto apply(const Tuple &x) {
+    return Op{}(evaluate<A, Offset>::apply(x),
+                evaluate<B, Offset + leaf_count<A>::value>::apply(x));
+  }
+};
+
+inline auto leaves(const Leaf &leaf) { return std::tuple{leaf.var}; }
+template <class Op, class... Args>
+auto leaves(const Node<Op, Args...> &node) {
+  return std::apply(
+      [](const auto &... args) { return std::tuple_cat(leaves(args)...); },
+      node.args);
+}
+
+template <class T, std::size_t> using repeat = T;
+/// Type combination for transform with N inputs of type T.
+template <class T, std::size_t... Is>
+auto same_types(std::index_sequence<Is...>) {
+  if constexpr (sizeof...(Is) == 1)
+    return T{};
+  else
+    return std::tuple<repeat<T, Is>...>{};
+}
+
+struct plus {
+  template <class A, class B> auto operator()(const A &a, const B &b) const {
+    return a + b;
+  }
+};
+struct minus {
+  template <class A, class B> auto operator()(const A &a, const B &b) const {
+    return a - b;
+  }
+};
+struct times {
+  template <class A, class B> auto operator()(const A &a, const B &b) const {
+    return a * b;
+  }
+};
+struct divide {
+  template <class A, class B> auto operator()(const A &a, const B &b) const {
+    return a / b;
+  }
+};
+struct negative {
+  template <class A> auto operator()(const A &a) const { return -a; }
+};
+struct sqrt {
+  template <class A> auto operator()(const A &a) const {
+    using std::sqrt;
+    return sqrt(a);
+  }
+};
+struct abs {
+  template <class A> auto operator()(const A &a) const {
+    using std::abs;
+    return abs(a);
+  }
+};
+struct reciprocal {
+  template <class A> auto operator()(const A &a) const {
+    if constexpr (std::is_same_v<A, units::Unit>)
+      return units::Unit(units::dimensionless) / a;
+    else if constexpr (std::is_same_v<A, VariableConstProxy> ||
+                       std::is_same_v<A, Variable>)
+      return core::reciprocal(a);
+    else
+      return static_cast<detail::element_type_t<A>>(1) / a;
+  }
+};
+} // namespace expression_detail
+
+/// Deferred elementwise operation on variables, see `lazy`.
+///
+/// Recording operations instead of applying them allows for evaluating an
+/// entire chain such as `(tof - tzero) * reciprocal(difc)` in a single pass via
+/// `transform`, without intermediate variables for the temporaries. The
+/// expression is evaluated by `eval()`, on conversion to Variable, or by a
+/// reduction.
+template <class E> class Expression {
+public:
+  explicit Expression(E tree) : m_tree(std::move(tree)) {}
+
+  const E &tree() const noexcept { return m_tree; }
+
+  /// Return the result of the expression.
+  ///
+  /// If all inputs are dense and have the same dtype (double or float) the
+  /// operations are fused into a single transform. Otherwise the operations
+  /// are applied one by one, just like without `lazy`.
+  Variable eval() const {
+    using namespace expression_detail;
+    const auto inputs = leaves(m_tree);
+    const auto first = std::get<0>(inputs).dtype();
+    const bool fusable = std::apply(
+        [first](const auto &... var) {
+          return (first == dtype<double> || first == dtype<float>) &&
+                 ((var.dtype() == first && !var.dims().sparse()) && ...);
+        },
+        inputs);
+    return std::apply(
+        [fusable](const auto &... var) {
+          if (!fusable)
+            return Variable(evaluate<E, 0>::apply(std::tuple{var...}));
+          constexpr auto N = sizeof...(var);
+          return detail::transform(
+              std::tuple{
+                  same_types<double>(std::make_index_sequence<N>{}),
+                  same_types<float>(std::make_index_sequence<N>{})},
+              [](const auto &... x) {
+                return evaluate<E, 0>::apply(std::forward_as_tuple(x...));
+              },
+              var...);
+        },
+        inputs);
+  }
+
+  operator Variable() const { return eval(); }
+
+private:
+  E m_tree;
+};
+
+/// Return an expression referring to `var`, for deferred evaluation of
+/// subsequent elementwise operations. `var` must outlive the expression.
+inline Expression<expression_detail::Leaf> lazy(const VariableConstProxy &var) {
+  return Expression{expression_detail::Leaf{var}};
+}
+
+namespace expression_detail {
+template <class E> const E &as_tree(const Expression<E> &expr) {
+  return expr.tree();
+}
+inline Leaf as_tree(const VariableConstProxy &var) { return Leaf{var}; }
+
+template <class T> struct is_expression : std::false_type {};
+template <class E> struct is_expression<Expression<E>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_operand_v =
+    is_expression<T>::value ||
+    std::is_convertible_v<const T &, VariableConstProxy>;
+
+/// Operands are expressions or variables, with at least one expression.
+template <class A, class B>
+using enable_if_expression_t =
+    std::enable_if_t<(is_expression<A>::value || is_expression<B>::value) &&
+                     is_operand_v<A> && is_operand_v<B>>;
+
+template <class Op, class... Args> auto make_node(const Args &... args) {
+  return Expression{Node<Op, std::decay_t<decltype(as_tree(args))>...>{
+      std::tuple{as_tree(args)...}}};
+}
+} // namespace expression_detail
+
+template <class A, class B,
+          class = expression_detail::enable_if_expression_t<A, B>>
+auto operator+(const A &a, const B &b) {
+  return expression_detail::make_node<expression_detail::plus>(a, b);
+}
+template <class A, class B,
+          class = expression_detail::enable_if_expression_t<A, B>>
+auto operator-(const A &a, const B &b) {
+  return expression_detail::make_node<expression_detail::minus>(a, b);
+}
+template <class A, class B,
+          class = expression_detail::enable_if_expression_t<A, B>>
+auto operator*(const A &a, const B &b) {
+  return expression_detail::make_node<expression_detail::times>(a, b);
+}
+template <class A, class B,
+          class = expression_detail::enable_if_expression_t<A, B>>
+auto operator/(const A &a, const B &b) {
+  return expression_detail::make_node<expression_detail::divide>(a, b);
+}
+template <class E> auto operator-(const Expression<E> &a) {
+  return expression_detail::make_node<expression_detail::negative>(a);
+}
+template <class E> auto sqrt(const Expression<E> &a) {
+  return expression_detail::make_node<expression_detail::sqrt>(a);
+}
+template <class E> auto abs(const Expression<E> &a) {
+  return expression_detail::make_node<expression_detail::abs>(a);
+}
+template <class E> auto reciprocal(const Expression<E> &a) {
+  return expression_detail::make_node<expression_detail::reciprocal>(a);
+}
+
+template <class E> Variable eval(const Expression<E> &expr) {
+  return expr.eval();
+}
+template <class E> Variable sum(const Expression<E> &expr, const Dim dim) {
+  return sum(expr.eval(), dim);
+}
+template <class E> Variable mean(const Expression<E> &expr, const Dim dim) {
+  return mean(expr.eval(), dim);
+}
+
+} // namespace scipp::core
+
+#endif // SCIPP_CORE_EXPRESSION_H
@@ -11,8 +11,32 @@
 
 #include <scipp/units/unit.h>
 
+#include "scipp-core_export.h"
+
 namespace scipp::core {
 
+class Variable;
+class VariableConstProxy;
+class DataArray;
+class DataConstProxy;
+class Dataset;
+class DatasetConstProxy;
+
+namespace detail {
+/// Return the concatenation of the slices of the input along `dim` given by
+/// `indices`, i.e., the input with slices reordered or filtered.
+///
+/// The output is allocated once and each run of consecutive indices is copied
+/// with a single call, so the cost is linear in the size of the output.
+SCIPP_CORE_EXPORT Variable gather(const VariableConstProxy &var, const Dim dim,
+                                  const std::vector<scipp::index> &indices);
+SCIPP_CORE_EXPORT DataArray gather(const DataConstProxy &array, const Dim dim,
+                                   const std::vector<scipp::index> &indices);
+SCIPP_CORE_EXPORT Dataset gather(const DatasetConstProxy &dataset,
+                                 const Dim dim,
+                                 const std::vector<scipp::index> &indices);
+} // namespace detail
+
 /// Index-based view of slices of a variable, data array, or dataset.
 ///
 /// The main purpose is to provide common means of handling a collection of
@@ -33,10 +57,14 @@ public:
   IndexedSliceView(T &data, const Dim dim, std::vector<scipp::index> index)
       : m_data(&data), m_dim(dim), m_index(index) {}
 
+  /// The sliced data.
+  constexpr T &data() const noexcept { return *m_data; }
   /// Slicing dimension.
   constexpr Dim dim() const noexcept { return m_dim; }
   /// Number of slices.
   constexpr scipp::index size() const noexcept { return m_index.size(); }
+  /// Indices of the slices.
+  const std::vector<scipp::index> &indices() const noexcept { return m_index; }
 
   /// The slice with given index.
   auto operator[](const scipp::index index) const {
@@ -60,12 +88,7 @@ private:
 
 /// Concatenate all slices of an IndexedSliceView along the view's dimension.
 template <class T> auto concatenate(const IndexedSliceView<T> &view) {
-  // TODO Recursive implementation a bit like merge sort for better performance.
-  // Could also try to find continuous ranges in indices.
-  auto out = copy(view[0]);
-  for (scipp::index i = 1; i < view.size(); ++i)
-    out = concatenate(out, view[i], view.dim());
-  return out;
+  return detail::gather(view.data(), view.dim(), view.indices());
 }
 
 } // namespace scipp::core
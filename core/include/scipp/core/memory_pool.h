@@ -6,95 +6,77 @@
 #define SCIPP_CORE_MEMORY_POOL_H
 
 #include <array>
-#include <map>
-#include <mutex>
+#include <cstddef>
 #include <vector>
 
-#include "scipp/common/index.h"
+#include "scipp-core_export.h"
 
 namespace scipp::core {
-#ifdef _WIN32
-// https://stackoverflow.com/questions/33696092/whats-the-correct-replacement-for-posix-memalign-in-windows
-static int check_align(size_t align) {
-  for (size_t i = sizeof(void *); i != 0; i *= 2)
-    if (align == i)
-      return 0;
-  return EINVAL;
-}
 
-static int posix_memalign(void **ptr, size_t align, size_t size) {
-  if (check_align(align))
-    return EINVAL;
+/// Caching allocator for the arrays of elements of variables.
+///
+/// Requested sizes are rounded up to size classes, four per power of two, and
+/// freed blocks are kept in a cache for reuse by subsequent allocations of the
+/// same class. This avoids expensive allocation and page faults of large
+/// buffers in chains of operations creating temporaries, such as `a * b + c`.
+///
+/// There is one pool per thread, obtained using `local()`, so no locking is
+/// required. Blocks may be deallocated by a different thread than the one that
+/// allocated them. The cache of each thread is limited by
+/// `max_cached_bytes()`, blocks exceeding the limit are returned to the system.
+class SCIPP_CORE_EXPORT MemoryPool {
+public:
+  /// Alignment of all blocks, suitable for vectorization.
+  static constexpr std::size_t alignment = 64;
+  static constexpr std::size_t min_block_size = 64;
 
-  int saved_errno = errno;
-  void *p = _aligned_malloc(size, align);
-  if (p == NULL) {
-    errno = saved_errno;
-    return ENOMEM;
-  }
+  MemoryPool() = default;
+  MemoryPool(const MemoryPool &) = delete;
+  MemoryPool &operator=(const MemoryPool &) = delete;
+  ~MemoryPool();
 
-  *ptr = p;
-  return 0;
-}
-#endif
+  void *allocate(const std::size_t size);
+  void deallocate(void *ptr, const std::size_t size) noexcept;
+  void release() noexcept;
+  /// Return the total size of blocks held in the cache.
+  std::size_t cached_bytes() const noexcept { return m_cached_bytes; }
 
-class MemoryPool {
-public:
-  void *allocate(size_t size) const {
-    std::lock_guard<std::mutex> g(m_mutex);
-    auto &pools = m_pools[size];
-    if (pools[1].empty()) {
-      void *ptr = nullptr;
-      // Always 64 bit aligned
-      int rc = posix_memalign(&ptr, 64, size);
-      if (rc != 0)
-        throw std::runtime_error("Failed to allocate.");
-      pools[0].emplace_back(ptr);
-      return ptr;
-    } else {
-      pools[0].emplace_back(pools[1].back());
-      pools[1].pop_back();
-      return pools[0].back();
-    }
-  }
-  void deallocate(void *ptr) const {
-    std::lock_guard<std::mutex> g(m_mutex);
-    for (auto &pools : m_pools) {
-      auto &used = pools.second[0];
-      for (scipp::index i = used.size() - 1; i >= 0; --i) {
-        if (used[i] == ptr) {
-          auto &unused = pools.second[1];
-          used.erase(used.begin() + i);
-          unused.emplace_back(ptr);
-          return;
-        }
-      }
-    }
-    throw std::runtime_error(
-        "Request to deallocate memory that is not owned by us.");
+  static MemoryPool *local() noexcept;
+  static std::size_t max_cached_bytes() noexcept;
+  static void set_max_cached_bytes(const std::size_t bytes) noexcept;
+
+  /// Return the index of the size class of a block of given size.
+  static constexpr std::size_t size_class(const std::size_t size) noexcept {
+    if (size <= min_block_size)
+      return 0;
+    std::size_t exponent = 7; // 2^(exponent - 1) < size <= 2^exponent
+    while ((std::size_t{1} << exponent) < size)
+      ++exponent;
+    const std::size_t step = std::size_t{1} << (exponent - 3);
+    return 1 + 4 * (exponent - 7) + (size + step - 1) / step - 5;
   }
-  ~MemoryPool() {
-    for (auto &pools : m_pools) {
-      for (auto &pool : pools.second)
-        for (auto &ptr : pool)
-#ifdef _WIN32
-          _aligned_free(ptr);
-#else
-          free(ptr);
-#endif
-    }
+
+  /// Return the size of blocks in given size class.
+  static constexpr std::size_t class_size(const std::size_t index) noexcept {
+    if (index == 0)
+      return min_block_size;
+    const std::size_t exponent = 7 + (index - 1) / 4;
+    const std::size_t step = std::size_t{1} << (exponent - 3);
+    return (5 + (index - 1) % 4) * step;
   }
 
 private:
-  mutable std::mutex m_mutex;
-  // Different pool for each size.
-  mutable std::map<size_t, std::array<std::vector<void *>, 2>> m_pools;
+  static constexpr std::size_t num_classes = 1 + 4 * (64 - 7);
+  std::array<std::vector<void *>, num_classes> m_cache;
+  std::size_t m_cached_bytes{0};
 };
 
-inline MemoryPool &instance() {
-  static MemoryPool pool;
-  return pool;
-}
+/// Allocate from the pool of the calling thread.
+SCIPP_CORE_EXPORT void *pool_allocate(const std::size_t size);
+/// Return a block obtained from pool_allocate to the pool of the calling
+/// thread. `size` must match the size passed to pool_allocate.
+SCIPP_CORE_EXPORT void pool_deallocate(void *ptr,
+                                       const std::size_t size) noexcept;
 
 } // namespace scipp::core
 
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#ifndef SCIPP_CORE_PACKED_SPARSE_H
+#define SCIPP_CORE_PACKED_SPARSE_H
+
+#include <vector>
+
+#include "scipp-core_export.h"
+#include "scipp/common/index.h"
+#include "scipp/common/span.h"
+#include "scipp/core/variable.h"
+
+namespace scipp::core {
+
+/// Sparse data stored in compressed sparse row (CSR) layout.
+///
+/// The events of all elements are stored in a single dense buffer along the
+/// sparse dimension, with variances in a second buffer if present. The events
+/// of the i-th element of the dense dimensions are the range
+/// [offsets()[i], offsets()[i + 1]) of the buffer. Compared to a Variable with
+/// elements of type `sparse_container`, this avoids one allocation per element
+/// and the capacity overhead of each container, and passes over all events
+/// access memory sequentially.
+class SCIPP_CORE_EXPORT PackedSparse {
+public:
+  PackedSparse() = default;
+  explicit PackedSparse(const VariableConstProxy &sparse);
+  PackedSparse(const Dimensions &dims, std::vector<scipp::index> offsets,
+               Variable buffer);
+
+  /// Return the dimensions, including the sparse dimension.
+  const Dimensions &dims() const noexcept { return m_dims; }
+  units::Unit unit() const { return m_buffer.unit(); }
+  DType dtype() const noexcept { return m_buffer.dtype(); }
+  bool hasVariances() const noexcept { return m_buffer.hasVariances(); }
+
+  /// Return the offsets of the events of each element into the buffer.
+  ///
+  /// The size is the volume of the dense dimensions plus one.
+  scipp::span<const scipp::index> offsets() const noexcept {
+    return m_offsets;
+  }
+  /// Return the total number of events.
+  scipp::index size() const noexcept { return m_offsets.back(); }
+  /// Return the buffer holding all events, a dense Variable along the sparse
+  /// dimension.
+  VariableConstProxy buffer() const noexcept { return m_buffer; }
+  VariableProxy buffer() noexcept { return m_buffer; }
+
+  Variable view();
+  Variable view() const;
+  Variable unpack() const;
+
+private:
+  Dimensions m_dims;
+  std::vector<scipp::index> m_offsets{0};
+  Variable m_buffer;
+};
+
+} // namespace scipp::core
+
+#endif // SCIPP_CORE_PACKED_SPARSE_H
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+/// @file Minimal parallel_for for splitting loops over the cores of a machine.
+///
+/// The interface is modelled after TBB (`blocked_range`, `parallel_for`) such
+/// that kernels can be written without caring about the threading backend.
+/// All kernels share a single pool of worker threads, whose size can be limited
+/// using `set_max_threads`. Nested calls to `parallel_for` (e.g., from the
+/// per-element operation of a transform over sparse data) run serially in the
+/// calling thread.
+#ifndef SCIPP_CORE_PARALLEL_H
+#define SCIPP_CORE_PARALLEL_H
+
+#include <algorithm>
+#include <functional>
+
+#include "scipp-core_export.h"
+#include "scipp/common/index.h"
+
+namespace scipp::core::parallel {
+
+/// A half-open range [begin, end) that may be split into chunks of at least
+/// `grainsize` elements.
+class blocked_range {
+public:
+  constexpr blocked_range(const scipp::index begin, const scipp::index end,
+                          const scipp::index grainsize = 1) noexcept
+      : m_begin(begin), m_end(end),
+        m_grainsize(std::max(grainsize, scipp::index{1})) {}
+
+  constexpr scipp::index begin() const noexcept { return m_begin; }
+  constexpr scipp::index end() const noexcept { return m_end; }
+  constexpr scipp::index size() const noexcept { return m_end - m_begin; }
+  constexpr scipp::index grainsize() const noexcept { return m_grainsize; }
+  constexpr bool empty() const noexcept { return m_begin >= m_end; }
+
+private:
+  scipp::index m_begin;
+  scipp::index m_end;
+  scipp::index m_grainsize;
+};
+
+/// Set the maximum number of threads used by parallel algorithms, including the
+/// calling thread.
+///
+/// A value of 0 selects the number of hardware threads, which is the default.
+/// Limit this when running several processes per machine to avoid
+/// oversubscription. Must not be called from within a parallel algorithm.
+SCIPP_CORE_EXPORT void set_max_threads(const scipp::index n);
+/// Return the maximum number of threads used by parallel algorithms.
+SCIPP_CORE_EXPORT scipp::index max_threads() noexcept;
+
+/// Default for the minimum number of elements processed by a single task.
+static constexpr scipp::index default_grainsize = 10000;
+/// Set the minimum number of elements processed by a single task.
+///
+/// This is used by kernels with a small and roughly constant cost per element,
+/// such as transform. Larger values reduce scheduling overhead, smaller values
+/// allow for parallelization of smaller arrays.
+SCIPP_CORE_EXPORT void set_grainsize(const scipp::index grainsize);
+/// Return the minimum number of elements processed by a single task.
+SCIPP_CORE_EXPORT scipp::index grainsize() noexcept;
+
+/// Set whether reductions partition their input independently of the number
+/// of threads.
+///
+/// Reductions combine partial results from chunks of their input in a fixed
+/// order, so results are reproducible for a given number of threads. If this is
+/// enabled the chunking is also independent of the number of threads, such that
+/// floating-point results are bitwise identical on any machine, at the cost of
+/// creating partial results even when running on a single thread.
+SCIPP_CORE_EXPORT void set_deterministic_reductions(const bool value) noexcept;
+/// Return true if reductions partition their input independently of the number
+/// of threads.
+SCIPP_CORE_EXPORT bool deterministic_reductions() noexcept;
+
+namespace detail {
+/// Return true if the calling thread is currently executing a chunk of a
+/// parallel_for.
+SCIPP_CORE_EXPORT bool in_parallel_region() noexcept;
+/// Return the number of chunks to split a range into.
+SCIPP_CORE_EXPORT scipp::index chunk_count(const blocked_range &range) noexcept;
+/// Call `task(i)` for all i in [0, n_tasks), distributed over the threads of
+/// the pool. The first exception thrown by any task is rethrown in the calling
+/// thread. If the pool is busy with a call from another thread the tasks are
+/// run serially in the calling thread.
+SCIPP_CORE_EXPORT void
+run_tasks(const scipp::index n_tasks,
+          const std::function<void(scipp::index)> &task);
+} // namespace detail
+
+/// Call `op` with non-overlapping sub-ranges of `range`, potentially from
+/// multiple threads concurrently.
+///
+/// `op` must be safe to call concurrently for disjoint sub-ranges. No ordering
+/// of the calls is guaranteed.
+template <class Op> void parallel_for(const blocked_range &range, Op &&op) {
+  const auto n_chunks = detail::chunk_count(range);
+  if (n_chunks <= 1)
+    return op(range);
+  const auto size = range.size();
+  detail::run_tasks(n_chunks, [&](const scipp::index chunk) {
+    op(blocked_range(range.begin() + size * chunk / n_chunks,
+                     range.begin() + size * (chunk + 1) / n_chunks,
+                     range.grainsize()));
+  });
+}
+
+} // namespace scipp::core::parallel
+
+#endif // SCIPP_CORE_PARALLEL_H
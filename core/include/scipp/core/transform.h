@@ -25,6 +25,7 @@
 
 #include "scipp/common/overloaded.h"
 #include "scipp/core/except.h"
+#include "scipp/core/parallel.h"
 #include "scipp/core/transform_common.h"
 #include "scipp/core/value_and_variance.h"
 #include "scipp/core/values_and_variances.h"
@@ -78,6 +79,19 @@ template <class T>
 struct is_sparse<ValuesAndVariances<const sparse_container<T>>>
     : std::true_type {};
 template <class T> inline constexpr bool is_sparse_v = is_sparse<T>::value;
+
+template <class T> struct is_span : std::false_type {};
+template <class T> struct is_span<span<T>> : std::true_type {};
+template <class T> inline constexpr bool is_span_v = is_span<T>::value;
+
+/// True if the elements of `T` are sparse containers or spans, i.e., each
+/// element holds many values.
+template <class T, class = void>
+struct has_container_elements : std::false_type {};
+template <class T>
+struct has_container_elements<T, std::void_t<typename T::value_type>>
+    : std::bool_constant<is_sparse_v<typename T::value_type> ||
+                         is_span_v<typename T::value_type>> {};
 } // namespace transform_detail
 
 template <class T> static auto check_and_get_size(const T &a) {
@@ -140,8 +154,74 @@ template <class T> static constexpr auto get(const T &index) noexcept {
     return index.get();
 }
 
+/// Return the position of an index in the iteration space, as opposed to
+/// `get`, which returns the position in the underlying data.
+template <class T> static constexpr auto position(const T &index) noexcept {
+  if constexpr (std::is_integral_v<T>)
+    return index;
+  else
+    return index.index();
+}
+
+template <class T>
+static constexpr void set_index(T &index, const scipp::index i) noexcept {
+  if constexpr (std::is_integral_v<T>)
+    index = i;
+  else
+    index.setIndex(i);
+}
+
+template <class T>
+static constexpr void set_indices(T &indices, const scipp::index i) noexcept {
+  std::apply([i](auto &... index) { (set_index(index, i), ...); }, indices);
+}
+
 } // namespace iter
 
+/// Return true if iterating `data` visits some elements more than once, i.e.,
+/// if it is a view with a broadcast dimension.
+template <class T> static bool has_stride_zero(const T &data) {
+  if constexpr (is_VariableView_v<std::decay_t<T>>)
+    return data.hasStrideZero();
+  else if constexpr (detail::is_ValuesAndVariances_v<std::decay_t<T>>)
+    return has_stride_zero(data.values);
+  else
+    return false;
+}
+
+/// Return the minimum number of elements processed by a single task when
+/// transforming `Ts`. Elements of sparse data and subspans (as used by, e.g.,
+/// histogram) are expensive, so they are distributed over threads one by one.
+template <class... Ts> static scipp::index element_grainsize() noexcept {
+  if constexpr ((transform_detail::has_container_elements<
+                     std::decay_t<Ts>>::value ||
+                 ...))
+    return 1;
+  else
+    return parallel::grainsize();
+}
+
+/// Call `run` for chunks of the iteration space of `indices`, with a tuple of
+/// indices moved to the start of the chunk and the end of the chunk.
+///
+/// If `serial` is true the full range is processed in the calling thread.
+template <class... Ts, class Indices, class Run>
+static void for_each_chunk(const Indices &indices, const scipp::index size,
+                           const bool serial, Run &&run) {
+  const auto chunk = [&indices, &run](const parallel::blocked_range &range) {
+    auto begin = indices;
+    iter::set_indices(begin, range.begin());
+    auto end = std::get<0>(indices);
+    iter::set_index(end, range.end());
+    run(begin, end);
+  };
+  const parallel::blocked_range range(0, size, element_grainsize<Ts...>());
+  if (serial)
+    chunk(range);
+  else
+    parallel::parallel_for(range, chunk);
+}
+
 template <class Op, class Indices, class... Args, size_t... I>
 static constexpr auto call_impl(Op &&op, const Indices &indices,
                                 std::index_sequence<I...>, Args &&... args) {
@@ -199,13 +279,19 @@ static constexpr void call_in_place(Op &&op, const Indices &indices, Arg &&arg,
   }
 }
 
+/// Apply `op` to all elements, writing to `out`. The output is never
+/// broadcast, so chunks of elements can safely be processed in parallel.
 template <class Op, class Out, class... Ts>
 static void transform_elements(Op op, Out &&out, Ts &&... other) {
-  auto indices =
+  const auto indices =
       std::tuple{iter::begin_index(out), iter::begin_index(other)...};
-  const auto end = iter::end_index(out);
-  for (; std::get<0>(indices) != end; iter::increment(indices))
-    call(op, indices, out, other...);
+  const auto size = iter::position(iter::end_index(out));
+  for_each_chunk<Out, Ts...>(indices, size, false,
+                             [&](auto begin, const auto &end) {
+                               for (; std::get<0>(begin) != end;
+                                    iter::increment(begin))
+                                 call(op, begin, out, other...);
+                             });
 }
 
 template <class T> struct element_type<ValueAndVariance<T>> { using type = T; };
@@ -356,7 +442,11 @@ template <class Op> struct Transform {
                   Variances(volume, default_init_elements))
             : makeVariable<element_type_t<Out>>(
                   Dimensions{dims}, Values(volume, default_init_elements));
-    auto &outT = static_cast<VariableConceptT<Out> &>(out.data());
+    // Access via the handle, since `data()` would prevent sharing the output
+    // buffer when copying the result.
+    auto &outT = static_cast<VariableConceptT<Out> &>(
+        std::visit([](auto &ptr) -> VariableConcept & { return *ptr; },
+                   out.dataHandle()));
     do_transform(op, outT, std::tuple<>(), as_view{*handles, dims}...);
     return out;
   }
@@ -500,10 +590,15 @@ template <bool dry_run> struct in_place {
     }
     if constexpr (dry_run)
       return;
-    // WARNING: Do not parallelize this loop in all cases! The output may have a
-    // dimension with stride zero so parallelization must be done with care.
-    for (; std::get<0>(indices) != end; iter::increment(indices))
-      call_in_place(op, indices, arg, other...);
+    // The output may have a dimension with stride zero, e.g., when
+    // accumulating, so elements are modified by more than one iteration. We
+    // only parallelize if each output element is visited exactly once.
+    for_each_chunk<T, Ts...>(
+        indices, iter::position(end), has_stride_zero(arg),
+        [&](auto begin, const auto &end_) {
+          for (; std::get<0>(begin) != end_; iter::increment(begin))
+            call_in_place(op, begin, arg, other...);
+        });
   }
 
   /// Recursion endpoint for do_transform_in_place.
@@ -785,11 +880,9 @@ Variable transform(std::tuple<Ts...> &&, Op op, const Vars &... vars) {
   auto unit = op(vars.unit()...);
   Variable out;
   try {
-    if constexpr ((is_any_sparse<Ts>::value || ...)) {
+    if constexpr ((is_any_sparse<Ts>::value || ...) ||
+                  sizeof...(Vars) > 2) {
       out = visit_impl<Ts...>::apply(Transform{op}, vars.dataHandle()...);
-    } else if constexpr (sizeof...(Vars) > 2) {
-      static_assert("Transform with more than 2 arguments not implemented "
-                    "yet for element-wise operation.");
     } else {
       out = core::visit(augment::insert_sparse(std::tuple<Ts...>{}))
                 .apply(Transform{overloaded_sparse{op, TransformSparse{}}},
@@ -207,29 +207,39 @@ public:
             const scipp::index otherEnd) override;
 };
 
+/// Handle to the data of a variable.
+///
+/// Copies of a handle to data (not views) share the underlying concept, which
+/// is copied on write, i.e., only once `detach` is called before modifying it.
+/// Once references to the data that may outlive a call have been handed out,
+/// such as spans or views, copies of the handle copy the data, since writes
+/// via these references must not be visible in the copy. Views are cheap to
+/// copy and are cloned.
 template <class... Known> class VariableConceptHandle_impl {
 public:
   using variant_t =
       std::variant<const VariableConcept *, const VariableConceptT<Known> *...>;
 
   VariableConceptHandle_impl()
-      : m_object(std::unique_ptr<VariableConcept>(nullptr)) {}
+      : m_object(std::shared_ptr<VariableConcept>(nullptr)) {}
   template <class T> VariableConceptHandle_impl(T object) {
     using value_t = typename T::element_type::value_type;
     if constexpr ((std::is_same_v<value_t, Known> || ...))
-      m_object = std::unique_ptr<VariableConceptT<value_t>>(std::move(object));
+      m_object = std::shared_ptr<VariableConceptT<value_t>>(std::move(object));
     else
-      m_object = std::unique_ptr<VariableConcept>(std::move(object));
+      m_object = std::shared_ptr<VariableConcept>(std::move(object));
   }
   VariableConceptHandle_impl(VariableConceptHandle_impl &&) = default;
   VariableConceptHandle_impl(const VariableConceptHandle_impl &other)
-      : VariableConceptHandle_impl(other ? other->clone()
-                                         : VariableConceptHandle_impl()) {}
+      : m_object(other.m_object) {
+    if (*this && (other.m_referenced || (*this)->isView()))
+      *this = (*this)->clone();
+  }
   VariableConceptHandle_impl &
   operator=(VariableConceptHandle_impl &&) = default;
   VariableConceptHandle_impl &
   operator=(const VariableConceptHandle_impl &other) {
-    if (*this && other) {
+    if (*this && other && unique()) {
       // Avoid allocation of new element_array if output is of correct shape.
       // This yields a 5x speedup in assignment operations of variables.
       auto &concept = **this;
@@ -241,21 +251,27 @@ public:
         return *this;
       }
     }
-    return *this = other ? other->clone() : VariableConceptHandle_impl();
+    return *this = VariableConceptHandle_impl(other);
   }
 
   explicit operator bool() const noexcept;
   VariableConcept &operator*() const;
   VariableConcept *operator->() const;
 
+  bool unique() const noexcept;
+  void detach();
+  /// Mark the data as referenced by spans or views, see class documentation.
+  void setReferenced() noexcept { m_referenced = true; }
+
   const auto &mutableVariant() const noexcept { return m_object; }
 
   variant_t variant() const noexcept;
 
 private:
-  std::variant<std::unique_ptr<VariableConcept>,
-               std::unique_ptr<VariableConceptT<Known>>...>
+  std::variant<std::shared_ptr<VariableConcept>,
+               std::shared_ptr<VariableConceptT<Known>>...>
       m_object;
+  bool m_referenced{false};
 };
 
 class VariableConstProxy;
@@ -460,7 +476,11 @@ public:
   const VariableConcept &data() const && = delete;
   const VariableConcept &data() const & { return *m_object; }
   VariableConcept &data() && = delete;
-  VariableConcept &data() & { return *m_object; }
+  VariableConcept &data() & {
+    m_object.detach();
+    m_object.setReferenced();
+    return *m_object;
+  }
 
   /// Return variant of pointers to underlying data.
   ///
@@ -469,7 +489,10 @@ public:
   auto dataHandle() const && = delete;
   auto dataHandle() const & { return m_object.variant(); }
   const auto &dataHandle() && = delete;
-  const auto &dataHandle() & { return m_object.mutableVariant(); }
+  const auto &dataHandle() & {
+    m_object.detach();
+    return m_object.mutableVariant();
+  }
 
   template <class T> void setVariances(detail::element_array<T> &&v);
 
@@ -662,6 +662,8 @@ const detail::element_array<T> &Variable::cast(const bool variances_) const {
 
 template <class T>
 detail::element_array<T> &Variable::cast(const bool variances_) {
+  m_object.detach();
+  m_object.setReferenced();
   auto &dm = requireT<DataModel<detail::element_array<T>>>(*m_object);
   if (!variances_)
     return dm.m_values;
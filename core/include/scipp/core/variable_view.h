@@ -167,6 +167,15 @@ public:
 
   const Dimensions &parentDimensions() const { return m_dimensions; }
 
+  /// Return true if the view broadcasts the underlying data along any
+  /// dimension, i.e., if iteration visits some elements more than once.
+  bool hasStrideZero() const {
+    for (const auto dim : m_targetDimensions.denseLabels())
+      if (!m_dimensions.denseContains(dim))
+        return true;
+    return false;
+  }
+
 private:
   T *m_variable;
   scipp::index m_offset{0};
@@ -18,14 +18,14 @@ template <class Variant> struct alternatives_are_const_ptr;
 template <class T, class... Ts>
 struct alternatives_are_const_ptr<std::variant<T, Ts...>> : std::true_type {};
 template <class T, class... Ts>
-struct alternatives_are_const_ptr<std::variant<std::unique_ptr<T>, Ts...>>
+struct alternatives_are_const_ptr<std::variant<std::shared_ptr<T>, Ts...>>
     : std::false_type {};
 
 template <class Variant, class T>
 using alternative =
     std::conditional_t<alternatives_are_const_ptr<std::decay_t<Variant>>::value,
                        const VariableConceptT<T> *,
-                       std::unique_ptr<VariableConceptT<T>>>;
+                       std::shared_ptr<VariableConceptT<T>>>;
 
 template <template <class...> class Tuple, class... T, class... V>
 static constexpr bool holds_alternatives(Tuple<T...> &&,
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#include "scipp/core/indexed_slice_view.h"
+#include "scipp/core/dataset.h"
+#include "scipp/core/except.h"
+
+namespace scipp::core::detail {
+
+namespace {
+/// Call `copy(offset, begin, end)` for every run of consecutive indices, with
+/// `offset` the position of the run in `indices` and [begin, end) the range of
+/// indices in the run.
+template <class Copy>
+void for_each_run(const std::vector<scipp::index> &indices, Copy copy) {
+  const auto size = scipp::size(indices);
+  for (scipp::index offset = 0; offset < size;) {
+    const auto begin = indices[offset];
+    auto end = begin + 1;
+    while (offset + end - begin < size && indices[offset + end - begin] == end)
+      ++end;
+    copy(offset, begin, end);
+    offset += end - begin;
+  }
+}
+
+/// Gather slices of `var`, which may be a bin-edge variable for a dimension of
+/// length `extent`.
+Variable gather_impl(const VariableConstProxy &var, const Dim dim,
+                     const std::vector<scipp::index> &indices,
+                     const scipp::index extent) {
+  auto dims = var.dims();
+  if (!dims.contains(dim))
+    return Variable(var);
+  const bool edges = dims[dim] == extent + 1;
+  const auto size = scipp::size(indices);
+  dims.resize(dim, edges && size > 0 ? size + 1 : size);
+  Variable out(var, dims);
+  for_each_run(indices, [&](const scipp::index offset, const scipp::index begin,
+                            const scipp::index end) {
+    if (edges) {
+      // Runs share their outer edges, so the edges must match.
+      if (offset != 0)
+        expect::equals(var.slice({dim, begin}), out.slice({dim, offset}));
+      out.data().copy(var.data(), dim, offset, begin, end + 1);
+    } else {
+      out.data().copy(var.data(), dim, offset, begin, end);
+    }
+  });
+  return out;
+}
+
+template <class T>
+auto gather_items(const T &items, const Dim dim,
+                  const std::vector<scipp::index> &indices,
+                  const scipp::index extent) {
+  std::map<typename T::key_type, typename T::mapped_type> out;
+  for (const auto &[key, item] : items)
+    out.emplace(key, gather_impl(item, dim, indices, extent));
+  return out;
+}
+} // namespace
+
+Variable gather(const VariableConstProxy &var, const Dim dim,
+                const std::vector<scipp::index> &indices) {
+  return gather_impl(var, dim, indices, var.dims()[dim]);
+}
+
+DataArray gather(const DataConstProxy &array, const Dim dim,
+                 const std::vector<scipp::index> &indices) {
+  const auto extent = array.dims()[dim];
+  return DataArray(array.hasData()
+                       ? gather_impl(array.data(), dim, indices, extent)
+                       : std::optional<Variable>(),
+                   gather_items(array.coords(), dim, indices, extent),
+                   gather_items(array.labels(), dim, indices, extent),
+                   gather_items(array.masks(), dim, indices, extent));
+}
+
+Dataset gather(const DatasetConstProxy &dataset, const Dim dim,
+               const std::vector<scipp::index> &indices) {
+  const auto extent = dataset.dimensions().at(dim);
+  Dataset out(std::map<std::string, Variable>(),
+              gather_items(dataset.coords(), dim, indices, extent),
+              gather_items(dataset.labels(), dim, indices, extent),
+              gather_items(dataset.masks(), dim, indices, extent),
+              std::map<std::string, Variable>());
+  // Consistent with slicing, items that do not depend on `dim` are dropped.
+  for (const auto &item : dataset)
+    if (item.dims().contains(dim))
+      out.setData(item.name(), gather(item, dim, indices));
+  return out;
+}
+
+} // namespace scipp::core::detail
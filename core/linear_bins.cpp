@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#include "linear_bins.h"
+#include "cpu_dispatch.h"
+
+namespace scipp::core::histogram_detail {
+
+namespace {
+template <class Event, class Edge>
+inline void linear_bin_indices_impl(const Event *__restrict events,
+                                    const scipp::index n, const Edge offset,
+                                    const Edge nbin, const Edge scale,
+                                    int32_t *__restrict bins) {
+  const auto outside = static_cast<int32_t>(nbin);
+  for (scipp::index i = 0; i < n; ++i) {
+    const Edge bin = (events[i] - offset) * scale;
+    // Comparisons with NaN are false, so NaN is outside as well.
+    bins[i] = bin >= Edge{0} && bin < nbin ? static_cast<int32_t>(bin)
+                                            : outside;
+  }
+}
+} // namespace
+
+SCIPP_CPU_DISPATCH
+void linear_bin_indices(const double *events, const scipp::index n,
+                        const double offset, const double nbin,
+                        const double scale, int32_t *bins) {
+  linear_bin_indices_impl(events, n, offset, nbin, scale, bins);
+}
+
+SCIPP_CPU_DISPATCH
+void linear_bin_indices(const float *events, const scipp::index n,
+                        const double offset, const double nbin,
+                        const double scale, int32_t *bins) {
+  linear_bin_indices_impl(events, n, offset, nbin, scale, bins);
+}
+
+SCIPP_CPU_DISPATCH
+void linear_bin_indices(const float *events, const scipp::index n,
+                        const float offset, const float nbin, const float scale,
+                        int32_t *bins) {
+  linear_bin_indices_impl(events, n, offset, nbin, scale, bins);
+}
+
+} // namespace scipp::core::histogram_detail
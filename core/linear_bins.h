@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#ifndef SCIPP_CORE_LINEAR_BINS_H
+#define SCIPP_CORE_LINEAR_BINS_H
+
+#include <cstdint>
+
+#include "scipp/common/index.h"
+
+namespace scipp::core::histogram_detail {
+
+/// Write the index of the bin of each of the `n` events to `bins`.
+///
+/// Bins have constant width, given by the parameters returned by
+/// `linear_edge_params`. Events outside the edges, including NaN, are assigned
+/// to the bin index `nbin`, such that callers can accumulate without branching.
+/// `nbin` must be less than 2^31.
+void linear_bin_indices(const double *events, const scipp::index n,
+                        const double offset, const double nbin,
+                        const double scale, int32_t *bins);
+void linear_bin_indices(const float *events, const scipp::index n,
+                        const double offset, const double nbin,
+                        const double scale, int32_t *bins);
+void linear_bin_indices(const float *events, const scipp::index n,
+                        const float offset, const float nbin, const float scale,
+                        int32_t *bins);
+
+} // namespace scipp::core::histogram_detail
+
+#endif // SCIPP_CORE_LINEAR_BINS_H
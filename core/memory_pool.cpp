@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "scipp/core/memory_pool.h"
+
+namespace scipp::core {
+
+namespace {
+void *allocate_aligned(const std::size_t size) {
+#ifdef _WIN32
+  void *ptr = _aligned_malloc(size, MemoryPool::alignment);
+#else
+  void *ptr = nullptr;
+  if (posix_memalign(&ptr, MemoryPool::alignment, size) != 0)
+    ptr = nullptr;
+#endif
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void free_aligned(void *ptr) noexcept {
+#ifdef _WIN32
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+std::atomic<std::size_t> cache_limit{std::size_t{512} * 1024 * 1024};
+
+/// Set when the pool of the calling thread has been destroyed, e.g., while
+/// variables with static storage duration are destroyed at exit.
+thread_local bool pool_destroyed = false;
+} // namespace
+
+MemoryPool::~MemoryPool() {
+  release();
+  pool_destroyed = true;
+}
+
+void *MemoryPool::allocate(const std::size_t size) {
+  if (size > std::size_t{1} << 62)
+    throw std::bad_alloc();
+  auto &cache = m_cache[size_class(size)];
+  if (cache.empty())
+    return allocate_aligned(class_size(size_class(size)));
+  void *ptr = cache.back();
+  cache.pop_back();
+  m_cached_bytes -= class_size(size_class(size));
+  return ptr;
+}
+
+void MemoryPool::deallocate(void *ptr, const std::size_t size) noexcept {
+  if (ptr == nullptr)
+    return;
+  const auto index = size_class(size);
+  const auto bytes = class_size(index);
+  auto &cache = m_cache[index];
+  if (m_cached_bytes + bytes > max_cached_bytes())
+    return free_aligned(ptr);
+  try {
+    cache.push_back(ptr);
+  } catch (std::bad_alloc &) {
+    return free_aligned(ptr);
+  }
+  m_cached_bytes += bytes;
+}
+
+/// Return all cached blocks to the system.
+void MemoryPool::release() noexcept {
+  for (auto &cache : m_cache) {
+    for (auto *ptr : cache)
+      free_aligned(ptr);
+    cache = std::vector<void *>{};
+  }
+  m_cached_bytes = 0;
+}
+
+/// Return the pool of the calling thread, or nullptr if it has been destroyed.
+MemoryPool *MemoryPool::local() noexcept {
+  if (pool_destroyed)
+    return nullptr;
+  thread_local MemoryPool pool;
+  return &pool;
+}
+
+/// Return the maximum size of the cache of each thread.
+std::size_t MemoryPool::max_cached_bytes() noexcept { return cache_limit; }
+
+/// Set the maximum size of the cache of each thread. Does not release blocks
+/// from caches that exceed the new limit.
+void MemoryPool::set_max_cached_bytes(const std::size_t bytes) noexcept {
+  cache_limit = bytes;
+}
+
+void *pool_allocate(const std::size_t size) {
+  if (auto *pool = MemoryPool::local())
+    return pool->allocate(size);
+  return allocate_aligned(
+      MemoryPool::class_size(MemoryPool::size_class(size)));
+}
+
+void pool_deallocate(void *ptr, const std::size_t size) noexcept {
+  if (auto *pool = MemoryPool::local())
+    pool->deallocate(ptr, size);
+  else
+    free_aligned(ptr);
+}
+
+} // namespace scipp::core
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#include <algorithm>
+
+#include "scipp/core/except.h"
+#include "scipp/core/packed_sparse.h"
+#include "scipp/core/parallel.h"
+
+namespace scipp::core {
+
+namespace packed_sparse_detail {
+/// Call `op` with a default-constructed value of the type matching `dtype`.
+template <class... Ts, class Op> Variable invoke(const DType dtype, Op op) {
+  Variable ret;
+  if (!((core::dtype<Ts> == dtype ? (ret = op(Ts{}), true) : false) || ...))
+    throw except::TypeError("Unsupported dtype.");
+  return ret;
+}
+
+/// Return pointers to all elements of `view`, in iteration order.
+template <class View> auto pointers(View &&view) {
+  std::vector<decltype(&*view.begin())> out;
+  out.reserve(view.size());
+  for (auto &item : view)
+    out.push_back(&item);
+  return out;
+}
+
+/// Copy the events of each sparse container to its range in the buffer.
+template <class T, class Events>
+void pack(const Events &events, const std::vector<scipp::index> &offsets,
+          T *buffer) {
+  parallel::parallel_for(
+      parallel::blocked_range(0, scipp::size(events)), [&](const auto &r) {
+        for (auto i = r.begin(); i < r.end(); ++i)
+          std::copy(events[i]->begin(), events[i]->end(), buffer + offsets[i]);
+      });
+}
+
+/// Assign the range of each sparse container from the buffer.
+template <class T, class Events>
+void unpack(const T *buffer, const scipp::span<const scipp::index> &offsets,
+            const Events &events) {
+  parallel::parallel_for(
+      parallel::blocked_range(0, scipp::size(events)), [&](const auto &r) {
+        for (auto i = r.begin(); i < r.end(); ++i)
+          events[i]->assign(buffer + offsets[i], buffer + offsets[i + 1]);
+      });
+}
+
+template <class T>
+auto make_spans(T *buffer, const scipp::span<const scipp::index> &offsets) {
+  std::vector<span<T>> spans;
+  spans.reserve(offsets.size() - 1);
+  for (scipp::index i = 0; i < scipp::size(offsets) - 1; ++i)
+    spans.emplace_back(buffer + offsets[i], buffer + offsets[i + 1]);
+  return spans;
+}
+
+/// Return Variable containing spans into the buffer as elements, one for each
+/// element of the dense dimensions.
+template <class T, class Buffer>
+Variable view(Buffer &buffer, const Dimensions &dims,
+              const scipp::span<const scipp::index> &offsets) {
+  using E = std::remove_const_t<T>;
+  const auto values =
+      make_spans<T>(buffer.template values<E>().data(), offsets);
+  if (buffer.hasVariances()) {
+    const auto variances =
+        make_spans<T>(buffer.template variances<E>().data(), offsets);
+    return makeVariable<span<T>>(Dimensions{denseDims(dims)}, buffer.unit(),
+                                 Values(values.begin(), values.end()),
+                                 Variances(variances.begin(), variances.end()));
+  } else {
+    return makeVariable<span<T>>(Dimensions{denseDims(dims)}, buffer.unit(),
+                                 Values(values.begin(), values.end()));
+  }
+}
+} // namespace packed_sparse_detail
+
+/// Pack the events of a sparse variable into a contiguous buffer.
+PackedSparse::PackedSparse(const VariableConstProxy &sparse)
+    : m_dims(sparse.dims()) {
+  using namespace packed_sparse_detail;
+  if (!m_dims.sparse())
+    throw except::DimensionError("Expected sparse data.");
+  m_buffer = invoke<double, float, int64_t, int32_t>(
+      sparse.dtype(), [&](const auto tag) {
+        using T = std::decay_t<decltype(tag)>;
+        const auto values = pointers(sparse.values<sparse_container<T>>());
+        m_offsets.resize(values.size() + 1);
+        for (scipp::index i = 0; i < scipp::size(values); ++i)
+          m_offsets[i + 1] = m_offsets[i] + scipp::size(*values[i]);
+        const Dim dim = m_dims.sparseDim();
+        auto buffer = sparse.hasVariances()
+                          ? makeVariable<T>(Dims{dim}, Shape{m_offsets.back()},
+                                            units::Unit(sparse.unit()),
+                                            Values{}, Variances{})
+                          : makeVariable<T>(Dims{dim}, Shape{m_offsets.back()},
+                                            units::Unit(sparse.unit()));
+        pack(values, m_offsets, buffer.template values<T>().data());
+        if (sparse.hasVariances())
+          pack(pointers(sparse.variances<sparse_container<T>>()), m_offsets,
+               buffer.template variances<T>().data());
+        return buffer;
+      });
+}
+
+/// Construct from events already stored in CSR layout.
+///
+/// `buffer` must be a dense variable along the sparse dimension of `dims`.
+/// `offsets` must start at zero, be non-decreasing, end at the size of
+/// `buffer`, and have one more entry than the volume of the dense dimensions.
+/// Together with unpack() this builds a sparse variable from flat arrays
+/// without assigning each sparse container individually.
+PackedSparse::PackedSparse(const Dimensions &dims,
+                           std::vector<scipp::index> offsets, Variable buffer)
+    : m_dims(dims), m_offsets(std::move(offsets)), m_buffer(std::move(buffer)) {
+  if (!m_dims.sparse())
+    throw except::DimensionError("Expected sparse dimensions.");
+  if (scipp::size(m_offsets) != m_dims.volume() + 1)
+    throw except::SizeError("Expected one offset per element of the dense "
+                            "dimensions plus one.");
+  if (m_offsets.front() != 0 ||
+      !std::is_sorted(m_offsets.begin(), m_offsets.end()))
+    throw except::SizeError(
+        "Expected offsets starting at zero in non-decreasing order.");
+  expect::equals(m_buffer.dims(),
+                 Dimensions(m_dims.sparseDim(), m_offsets.back()));
+}
+
+/// Return Variable with elements of type span<T>, one for each element of the
+/// dense dimensions, referencing the events in the buffer.
+///
+/// The returned variable can be used with `transform` like a sparse variable.
+/// It is invalidated if *this is destroyed.
+Variable PackedSparse::view() {
+  return packed_sparse_detail::invoke<double, float>(
+      dtype(), [&](const auto tag) {
+        using T = std::decay_t<decltype(tag)>;
+        return packed_sparse_detail::view<T>(m_buffer, m_dims, m_offsets);
+      });
+}
+
+/// Return Variable with elements of type span<const T>, one for each element
+/// of the dense dimensions, referencing the events in the buffer.
+Variable PackedSparse::view() const {
+  return packed_sparse_detail::invoke<double, float>(
+      dtype(), [&](const auto tag) {
+        using T = std::decay_t<decltype(tag)>;
+        return packed_sparse_detail::view<const T>(m_buffer, m_dims,
+                                                   m_offsets);
+      });
+}
+
+/// Return a sparse variable with the same events.
+Variable PackedSparse::unpack() const {
+  using namespace packed_sparse_detail;
+  return invoke<double, float, int64_t, int32_t>(dtype(), [&](const auto tag) {
+    using T = std::decay_t<decltype(tag)>;
+    auto sparse =
+        hasVariances()
+            ? makeVariable<T>(Dimensions{m_dims}, units::Unit(unit()),
+                              Values{}, Variances{})
+            : makeVariable<T>(Dimensions{m_dims}, units::Unit(unit()));
+    packed_sparse_detail::unpack(m_buffer.values<T>().data(), offsets(),
+                                 pointers(sparse.template sparseValues<T>()));
+    if (hasVariances())
+      packed_sparse_detail::unpack(
+          m_buffer.variances<T>().data(), offsets(),
+          pointers(sparse.template sparseVariances<T>()));
+    return sparse;
+  });
+}
+
+} // namespace scipp::core
@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "scipp/core/parallel.h"
+
+namespace scipp::core::parallel {
+
+namespace {
+std::atomic<bool> deterministic{false};
+std::atomic<scipp::index> min_grainsize{default_grainsize};
+
+scipp::index hardware_threads() noexcept {
+  return std::max(
+      scipp::index{1},
+      static_cast<scipp::index>(std::thread::hardware_concurrency()));
+}
+
+std::atomic<scipp::index> thread_limit{hardware_threads()};
+} // namespace
+
+void set_deterministic_reductions(const bool value) noexcept {
+  deterministic = value;
+}
+
+bool deterministic_reductions() noexcept { return deterministic; }
+
+void set_grainsize(const scipp::index grainsize) {
+  if (grainsize < 1)
+    throw std::invalid_argument("Grainsize must be positive.");
+  min_grainsize = grainsize;
+}
+
+scipp::index grainsize() noexcept { return min_grainsize; }
+
+scipp::index max_threads() noexcept { return thread_limit; }
+
+namespace detail {
+
+namespace {
+thread_local bool parallel_region = false;
+
+/// Marks the calling thread as executing a chunk of a parallel_for.
+class RegionGuard {
+public:
+  RegionGuard() noexcept : m_previous(parallel_region) {
+    parallel_region = true;
+  }
+  ~RegionGuard() { parallel_region = m_previous; }
+  RegionGuard(const RegionGuard &) = delete;
+  RegionGuard &operator=(const RegionGuard &) = delete;
+
+private:
+  bool m_previous;
+};
+
+/// A set of tasks, claimed one at a time by any participating thread.
+class Job {
+public:
+  Job(const scipp::index n_tasks,
+      const std::function<void(scipp::index)> &task) noexcept
+      : m_n_tasks(n_tasks), m_task(task) {}
+
+  /// Run tasks until all have been claimed.
+  void work() noexcept {
+    RegionGuard guard;
+    for (auto i = m_next++; i < m_n_tasks; i = m_next++) {
+      try {
+        m_task(i);
+      } catch (...) {
+        std::lock_guard lock(m_error_mutex);
+        if (!m_error)
+          m_error = std::current_exception();
+      }
+    }
+  }
+
+  /// Rethrow the first exception thrown by any of the tasks.
+  void rethrow() const {
+    if (m_error)
+      std::rethrow_exception(m_error);
+  }
+
+private:
+  const scipp::index m_n_tasks;
+  const std::function<void(scipp::index)> &m_task;
+  std::atomic<scipp::index> m_next{0};
+  std::mutex m_error_mutex;
+  std::exception_ptr m_error;
+};
+
+/// Persistent worker threads shared by all parallel algorithms.
+///
+/// The thread calling `run` participates in the work, i.e., a pool of size N
+/// has N-1 worker threads. Tasks are claimed dynamically by whichever thread
+/// becomes idle first, balancing tasks of uneven cost.
+class ThreadPool {
+public:
+  explicit ThreadPool(const scipp::index size) {
+    for (scipp::index i = 1; i < size; ++i)
+      m_workers.emplace_back([this]() { work(); });
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard lock(m_mutex);
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto &worker : m_workers)
+      worker.join();
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  scipp::index size() const noexcept { return scipp::size(m_workers) + 1; }
+
+  void run(const scipp::index n_tasks,
+           const std::function<void(scipp::index)> &task) {
+    Job job(n_tasks, task);
+    {
+      std::lock_guard lock(m_mutex);
+      m_job = &job;
+      ++m_generation;
+    }
+    m_wake.notify_all();
+    job.work();
+    {
+      // Workers that have picked up the job may still be running tasks.
+      std::unique_lock lock(m_mutex);
+      m_done.wait(lock, [this]() { return m_busy == 0; });
+      m_job = nullptr;
+    }
+    job.rethrow();
+  }
+
+private:
+  void work() {
+    scipp::index generation = 0;
+    while (true) {
+      Job *job = nullptr;
+      {
+        std::unique_lock lock(m_mutex);
+        m_wake.wait(lock, [&]() {
+          return m_stop || m_generation != generation;
+        });
+        if (m_stop)
+          return;
+        generation = m_generation;
+        // The job may have been completed already by other threads.
+        if (!m_job)
+          continue;
+        job = m_job;
+        ++m_busy;
+      }
+      job->work();
+      {
+        std::lock_guard lock(m_mutex);
+        --m_busy;
+      }
+      m_done.notify_all();
+    }
+  }
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  Job *m_job{nullptr};
+  scipp::index m_generation{0};
+  scipp::index m_busy{0};
+  bool m_stop{false};
+};
+
+/// Guards the pool. Held while running a job, such that only one job is
+/// scheduled at a time. Concurrent calls from other threads run serially.
+std::mutex pool_mutex;
+std::unique_ptr<ThreadPool> pool;
+} // namespace
+
+bool in_parallel_region() noexcept { return parallel_region; }
+
+scipp::index chunk_count(const blocked_range &range) noexcept {
+  if (in_parallel_region() || range.empty())
+    return 1;
+  return std::clamp(range.size() / range.grainsize(), scipp::index{1},
+                    max_threads());
+}
+
+void run_tasks(const scipp::index n_tasks,
+               const std::function<void(scipp::index)> &task) {
+  std::unique_lock lock(pool_mutex, std::try_to_lock);
+  if (lock && max_threads() > 1) {
+    if (!pool || pool->size() != max_threads())
+      pool = std::make_unique<ThreadPool>(max_threads());
+    return pool->run(n_tasks, task);
+  }
+  RegionGuard guard;
+  for (scipp::index i = 0; i < n_tasks; ++i)
+    task(i);
+}
+
+} // namespace detail
+
+void set_max_threads(const scipp::index n) {
+  if (n < 0)
+    throw std::invalid_argument("Number of threads must not be negative.");
+  std::lock_guard lock(detail::pool_mutex);
+  thread_limit = n == 0 ? hardware_threads() : n;
+  detail::pool.reset();
+}
+
+} // namespace scipp::core::parallel
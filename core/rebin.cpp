@@ -2,8 +2,13 @@
 // Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
 /// @file
 /// @author Simon Heybrock, Igor Gudich
+#include <algorithm>
+#include <optional>
+#include <vector>
+
 #include "scipp/core/apply.h"
 #include "scipp/core/except.h"
+#include "scipp/core/parallel.h"
 #include "scipp/core/variable.h"
 #include "scipp/units/except.h"
 
@@ -42,7 +47,7 @@ static void rebinInner(const Dim dim, const VariableConceptT<DataType> &oldT,
   // match, or coord is 1D.
   const bool jointOld = oldCoordT.dims().shape().size() == 1;
   const bool jointNew = newCoordT.dims().shape().size() == 1;
-  for (scipp::index c = 0; c < count; ++c) {
+  const auto rebin_row = [&](const scipp::index c) {
     scipp::index iold = 0;
     scipp::index inew = 0;
     const scipp::index oldEdgeOffset = jointOld ? 0 : c * (oldSize + 1);
@@ -74,22 +79,33 @@ static void rebinInner(const Dim dim, const VariableConceptT<DataType> &oldT,
         }
       }
     }
-  }
+  };
+  // Rows are independent, split them over threads.
+  const auto grainsize =
+      std::max(scipp::index{1}, parallel::grainsize() / (oldSize + newSize));
+  parallel::parallel_for(parallel::blocked_range(0, count, grainsize),
+                         [&](const auto &range) {
+                           for (auto c = range.begin(); c < range.end(); ++c)
+                             rebin_row(c);
+                         });
 }
 
-template <typename T>
-void rebin_non_inner(const Dim dim, const VariableConstProxy &oldT,
-                     Variable &newT, const VariableConstProxy &oldCoordT,
-                     const VariableConstProxy &newCoordT) {
-  const auto oldSize = oldT.dims()[dim];
-  const auto newSize = newT.dims()[dim];
+namespace rebin_detail {
+/// Overlap of an old and a new bin along the rebinned dimension.
+template <class T> struct Overlap {
+  scipp::index iold;
+  scipp::index inew;
+  T delta;
+  T owidth;
+};
 
-  const auto *xold = oldCoordT.values<T>().data();
-  const auto *xnew = newCoordT.values<T>().data();
-  // This function assumes that dimensions between coord and data
-  // coord is 1D.
-  int iold = 0;
-  int inew = 0;
+/// Return all overlapping pairs of old and new bins, given 1D bin-edges.
+template <class T>
+std::vector<Overlap<T>> overlaps(const T *xold, const scipp::index oldSize,
+                                 const T *xnew, const scipp::index newSize) {
+  std::vector<Overlap<T>> out;
+  scipp::index iold = 0;
+  scipp::index inew = 0;
   while ((iold < oldSize) && (inew < newSize)) {
     auto xo_low = xold[iold];
     auto xo_high = xold[iold + 1];
@@ -103,10 +119,7 @@ void rebin_non_inner(const Dim dim, const VariableConstProxy &oldT,
     else {
       // delta is the overlap of the bins on the x axis
       auto delta = std::min(xn_high, xo_high) - std::max(xn_low, xo_low);
-
-      auto owidth = xo_high - xo_low;
-      newT.slice({dim, inew}) +=
-          astype(oldT.slice({dim, iold}) * delta / owidth, newT.dtype());
+      out.push_back({iold, inew, delta, xo_high - xo_low});
       if (xn_high > xo_high) {
         iold++;
       } else {
@@ -114,7 +127,93 @@ void rebin_non_inner(const Dim dim, const VariableConstProxy &oldT,
       }
     }
   }
+  return out;
+}
+
+/// Add the overlapping fraction of old bins to new bins for all outer indices
+/// and the given range of columns, i.e., flat indices of (outer, inner).
+///
+/// For variances the fraction is squared, as when scaling a variable by a
+/// scalar.
+template <bool Variances, class D, class T>
+void rebin_columns(const D *in, D *out, const std::vector<Overlap<T>> &overlaps,
+                   const scipp::index oldSize, const scipp::index newSize,
+                   const scipp::index inner, const parallel::blocked_range &r) {
+  for (auto o = r.begin() / inner; o * inner < r.end(); ++o) {
+    const auto begin = std::max(r.begin() - o * inner, scipp::index{0});
+    const auto end = std::min(r.end() - o * inner, inner);
+    for (const auto &[iold, inew, delta, owidth] : overlaps) {
+      const auto *in_line = in + (o * oldSize + iold) * inner;
+      auto *out_line = out + (o * newSize + inew) * inner;
+      for (auto i = begin; i < end; ++i) {
+        if constexpr (std::is_same_v<D, bool>)
+          out_line[i] = out_line[i] || in_line[i];
+        else if constexpr (Variances)
+          out_line[i] +=
+              static_cast<D>(in_line[i] * (delta * delta) / (owidth * owidth));
+        else
+          out_line[i] += static_cast<D>(in_line[i] * delta / owidth);
+      }
+    }
+  }
+}
+
+template <class D, class T>
+void rebin_non_inner(const Dim dim, const VariableConstProxy &oldT,
+                     Variable &newT, const std::vector<Overlap<T>> &overlaps) {
+  // The kernel requires contiguous input, slices are copied.
+  std::optional<Variable> copy;
+  if (!oldT.data().isContiguous())
+    copy = Variable(oldT);
+  const auto in = copy ? VariableConstProxy(*copy) : oldT;
+  const auto &dims = in.dims();
+  const auto oldSize = dims[dim];
+  const auto newSize = newT.dims()[dim];
+  const auto inner = dims.offset(dim);
+  const auto columns = dims.volume() / oldSize;
+  const auto grainsize = std::max(
+      scipp::index{1}, parallel::grainsize() / (1 + scipp::size(overlaps)));
+  // Columns are independent, split them over threads.
+  const parallel::blocked_range range(0, columns, grainsize);
+  parallel::parallel_for(range, [&](const auto &r) {
+    rebin_columns<false>(in.values<D>().data(), newT.values<D>().data(),
+                         overlaps, oldSize, newSize, inner, r);
+  });
+  if (in.hasVariances())
+    parallel::parallel_for(range, [&](const auto &r) {
+      rebin_columns<true>(in.variances<D>().data(), newT.variances<D>().data(),
+                          overlaps, oldSize, newSize, inner, r);
+    });
+}
+
+/// Rebin a dimension other than the inner dimension in a single strided pass
+/// over the data, without creating temporaries per bin.
+template <typename T>
+void rebin_non_inner(const Dim dim, const VariableConstProxy &oldT,
+                     Variable &newT, const VariableConstProxy &oldCoordT,
+                     const VariableConstProxy &newCoordT) {
+  // This function assumes that dimensions between coord and data
+  // coord is 1D.
+  const auto overlaps_ = overlaps(
+      oldCoordT.values<T>().data(), oldT.dims()[dim],
+      newCoordT.values<T>().data(), newT.dims()[dim]);
+  switch (oldT.dtype()) {
+  case dtype<double>:
+    return rebin_non_inner<double>(dim, oldT, newT, overlaps_);
+  case dtype<float>:
+    return rebin_non_inner<float>(dim, oldT, newT, overlaps_);
+  case dtype<int64_t>:
+    return rebin_non_inner<int64_t>(dim, oldT, newT, overlaps_);
+  case dtype<int32_t>:
+    return rebin_non_inner<int32_t>(dim, oldT, newT, overlaps_);
+  case dtype<bool>:
+    return rebin_non_inner<bool>(dim, oldT, newT, overlaps_);
+  default:
+    throw except::TypeError("Cannot rebin non-inner dimension of dtype ",
+                            oldT);
+  }
 }
+} // namespace rebin_detail
 
 Variable rebin(const VariableConstProxy &var, const Dim dim,
                const VariableConstProxy &oldCoord,
@@ -176,10 +275,12 @@ Variable rebin(const VariableConstProxy &var, const Dim dim,
           "Not inner rebin works only for 1d coordinates for now.");
     switch (oldCoord.dtype()) {
     case dtype<double>:
-      rebin_non_inner<double>(dim, var, rebinned, oldCoord, newCoord);
+      rebin_detail::rebin_non_inner<double>(dim, var, rebinned, oldCoord,
+                                            newCoord);
       break;
     case dtype<float>:
-      rebin_non_inner<float>(dim, var, rebinned, oldCoord, newCoord);
+      rebin_detail::rebin_non_inner<float>(dim, var, rebinned, oldCoord,
+                                           newCoord);
       break;
     default:
       throw std::runtime_error(
@@ -2,32 +2,180 @@
 // Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
 /// @file
 /// @author Simon Heybrock
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <numeric>
+#include <type_traits>
 
 #include "scipp/core/except.h"
 #include "scipp/core/indexed_slice_view.h"
+#include "scipp/core/parallel.h"
 #include "scipp/core/sort.h"
 #include "scipp/core/tag_util.h"
 
 namespace scipp::core {
 
+namespace sort_detail {
+/// Keys shorter than this are sorted using std::stable_sort.
+static constexpr scipp::index min_size = 4096;
+/// Minimum number of keys processed by a single task.
+static constexpr scipp::index grainsize = 65536;
+
+/// Return an unsigned integer with the same ordering as `x`.
+///
+/// For signed integers the sign bit is flipped. For floating-point numbers all
+/// bits of negative numbers are flipped and only the sign bit of positive
+/// numbers, such that the unsigned comparison matches that of the floats. NaN
+/// is sorted to the beginning or end, depending on its sign bit.
+template <class T> auto radix_key(const T x) noexcept {
+  if constexpr (std::is_same_v<T, bool>) {
+    return static_cast<uint8_t>(x);
+  } else if constexpr (std::is_integral_v<T>) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<U>(static_cast<U>(x) ^ (U{1} << (8 * sizeof(T) - 1)));
+  } else {
+    using U = std::conditional_t<sizeof(T) == 8, uint64_t, uint32_t>;
+    // -0.0 and 0.0 compare equal, so they must map to the same key.
+    const T value = x == T{0} ? T{0} : x;
+    U bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    constexpr U sign = U{1} << (8 * sizeof(T) - 1);
+    return bits & sign ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+  }
+}
+
+/// Call `op(chunk, begin, end)` for `n_chunks` consecutive chunks of [0, size),
+/// in parallel.
+template <class Op>
+void for_each_chunk(const scipp::index size, const scipp::index n_chunks,
+                    Op op) {
+  parallel::parallel_for(
+      parallel::blocked_range(0, n_chunks), [&](const auto &range) {
+        for (auto chunk = range.begin(); chunk < range.end(); ++chunk)
+          op(chunk, size * chunk / n_chunks, size * (chunk + 1) / n_chunks);
+      });
+}
+
+/// Stable parallel LSD radix sort with 8-bit digits, returning the permutation
+/// that sorts `values`.
+///
+/// Each pass counts digits per chunk, and scatters every chunk to the offsets
+/// given by the prefix sum of the counts. Passes for digits that are equal for
+/// all keys, e.g., the high bytes of small integers, are skipped.
+template <class Values> auto radix_sort(const Values &values) {
+  const auto size = scipp::size(values);
+  using U = decltype(radix_key(values[0]));
+  const auto n_chunks = parallel::detail::chunk_count(
+      parallel::blocked_range(0, size, grainsize));
+  std::vector<U> keys(size);
+  std::vector<U> keys_out(size);
+  std::vector<scipp::index> permutation(size);
+  std::vector<scipp::index> permutation_out(size);
+  for_each_chunk(size, n_chunks, [&](auto, const auto begin, const auto end) {
+    for (auto i = begin; i < end; ++i) {
+      keys[i] = radix_key(values[i]);
+      permutation[i] = i;
+    }
+  });
+
+  using Counts = std::array<scipp::index, 256>;
+  std::vector<Counts> offsets(n_chunks);
+  for (size_t shift = 0; shift < 8 * sizeof(U); shift += 8) {
+    const auto digit = [shift](const U key) { return (key >> shift) & 0xff; };
+    for_each_chunk(size, n_chunks,
+                   [&](const auto chunk, const auto begin, const auto end) {
+                     auto &counts = offsets[chunk];
+                     counts.fill(0);
+                     for (auto i = begin; i < end; ++i)
+                       ++counts[digit(keys[i])];
+                   });
+    Counts total{};
+    for (const auto &counts : offsets)
+      for (size_t d = 0; d < 256; ++d)
+        total[d] += counts[d];
+    // All keys have the same digit, nothing to do in this pass.
+    if (std::find(total.begin(), total.end(), size) != total.end())
+      continue;
+    scipp::index offset = 0;
+    for (size_t d = 0; d < 256; ++d)
+      for (auto &counts : offsets) {
+        const auto count = counts[d];
+        counts[d] = offset;
+        offset += count;
+      }
+    for_each_chunk(size, n_chunks,
+                   [&](const auto chunk, const auto begin, const auto end) {
+                     auto &positions = offsets[chunk];
+                     for (auto i = begin; i < end; ++i) {
+                       const auto pos = positions[digit(keys[i])]++;
+                       keys_out[pos] = keys[i];
+                       permutation_out[pos] = permutation[i];
+                     }
+                   });
+    std::swap(keys, keys_out);
+    std::swap(permutation, permutation_out);
+  }
+  return permutation;
+}
+
+/// Stable parallel merge sort, returning the permutation that sorts `values`.
+///
+/// Chunks are sorted concurrently and subsequently merged pairwise.
+template <class Values> auto merge_sort(const Values &values) {
+  const auto size = scipp::size(values);
+  const auto n_chunks = parallel::detail::chunk_count(
+      parallel::blocked_range(0, size, grainsize));
+  std::vector<scipp::index> permutation(size);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  const auto less = [&values](const scipp::index i, const scipp::index j) {
+    return values[i] < values[j];
+  };
+  const auto it = [&](const scipp::index chunk) {
+    return permutation.begin() + size * std::min(chunk, n_chunks) / n_chunks;
+  };
+  for_each_chunk(size, n_chunks, [&](const auto chunk, auto, auto) {
+    std::stable_sort(it(chunk), it(chunk + 1), less);
+  });
+  for (scipp::index width = 1; width < n_chunks; width *= 2) {
+    const auto pairs = (n_chunks + 2 * width - 1) / (2 * width);
+    for_each_chunk(pairs, pairs, [&](const auto pair, auto, auto) {
+      const auto first = 2 * width * pair;
+      std::inplace_merge(it(first), it(first + width), it(first + 2 * width),
+                         less);
+    });
+  }
+  return permutation;
+}
+} // namespace sort_detail
+
 template <class T> struct MakePermutation {
   static auto apply(const VariableConstProxy &key) {
+    using namespace sort_detail;
     if (key.dims().ndim() != 1)
       throw except::DimensionError("Sort key must be 1-dimensional");
 
     // Variances are ignored for sorting.
     const auto &values = key.values<T>();
 
+    if (scipp::size(values) >= min_size) {
+      if constexpr (std::is_arithmetic_v<T>)
+        return radix_sort(values);
+      else
+        return merge_sort(values);
+    }
     std::vector<scipp::index> permutation(values.size());
     std::iota(permutation.begin(), permutation.end(), 0);
-    std::sort(
+    std::stable_sort(
         permutation.begin(), permutation.end(),
         [&](scipp::index i, scipp::index j) { return values[i] < values[j]; });
     return permutation;
   }
 };
 
+/// Return the permutation that sorts `key`. The sort is stable, i.e., the
+/// order of equal elements is preserved.
 static auto makePermutation(const VariableConstProxy &key) {
   return CallDType<double, float, int64_t, int32_t, bool,
                    std::string>::apply<MakePermutation>(key.dtype(), key);
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "scipp/core/arena_allocator.h"
+#include "scipp/core/dtype.h"
+#include "scipp/core/element_array.h"
+#include "scipp/core/variable.h"
+
+using namespace scipp;
+using namespace scipp::core;
+using scipp::core::detail::Arena;
+using scipp::core::detail::element_array;
+
+TEST(ArenaTest, allocate_aligned) {
+  Arena arena;
+  auto *a = arena.allocate(3, 1);
+  auto *b = arena.allocate(8, 8);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 8, 0);
+  EXPECT_EQ(arena.reserved(), Arena::min_chunk_size);
+}
+
+TEST(ArenaTest, allocate_large) {
+  Arena arena;
+  arena.allocate(8, 8);
+  auto *p = static_cast<std::byte *>(arena.allocate(100000, 8));
+  p[99999] = std::byte{1};
+  EXPECT_EQ(arena.reserved(), Arena::min_chunk_size + 100000);
+}
+
+TEST(ArenaAllocatorTest, default_uses_heap) {
+  sparse_container<double> c{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  EXPECT_FALSE(c.get_allocator().arena());
+}
+
+TEST(ArenaAllocatorTest, element_array_elements_share_arena) {
+  element_array<sparse_container<double>> x(3);
+  const auto arena = x.data()[0].get_allocator().arena();
+  ASSERT_TRUE(arena);
+  EXPECT_EQ(x.data()[1].get_allocator().arena(), arena);
+  EXPECT_EQ(x.data()[2].get_allocator().arena(), arena);
+
+  x.resize(2);
+  EXPECT_TRUE(x.data()[0].get_allocator().arena());
+  EXPECT_NE(x.data()[0].get_allocator().arena(), arena);
+}
+
+TEST(ArenaAllocatorTest, element_array_copy_uses_new_arena) {
+  element_array<sparse_container<double>> x(2);
+  x.data()[0].assign(20, 1.0);
+  x.data()[1].assign(30, 2.0);
+  const auto used = x.data()[0].get_allocator().arena()->reserved();
+  EXPECT_GT(used, 0);
+
+  const auto y(x);
+  const auto &arena = y.data()[0].get_allocator().arena();
+  EXPECT_NE(arena, x.data()[0].get_allocator().arena());
+  EXPECT_EQ(y.data()[1].get_allocator().arena(), arena);
+  EXPECT_EQ(arena->reserved(), used);
+  EXPECT_EQ(y.data()[0], x.data()[0]);
+  EXPECT_EQ(y.data()[1], x.data()[1]);
+}
+
+TEST(ArenaAllocatorTest, copied_container_uses_heap) {
+  element_array<sparse_container<double>> x(1);
+  x.data()[0].assign(20, 1.0);
+  const auto copy(x.data()[0]);
+  EXPECT_FALSE(copy.get_allocator().arena());
+  EXPECT_EQ(copy, x.data()[0]);
+}
+
+TEST(ArenaAllocatorTest, moved_container_outlives_array) {
+  sparse_container<double> moved;
+  {
+    element_array<sparse_container<double>> x(1);
+    x.data()[0].assign(20, 1.0);
+    moved = std::move(x.data()[0]);
+  }
+  EXPECT_TRUE(moved.get_allocator().arena());
+  EXPECT_EQ(moved, sparse_container<double>(20, 1.0));
+  moved.push_back(2.0);
+  EXPECT_EQ(moved.size(), 21);
+}
+
+TEST(ArenaAllocatorTest, sparse_variable) {
+  auto var = makeVariable<double>(Dims{Dim::Y, Dim::X},
+                                  Shape{2, Dimensions::Sparse}, Values{},
+                                  Variances{});
+  auto vals = var.sparseValues<double>();
+  auto vars = var.sparseVariances<double>();
+  vals[0].assign(10, 1.0);
+  vals[1].assign(20, 2.0);
+  vars[0].assign(10, 3.0);
+  vars[1].assign(20, 4.0);
+  EXPECT_TRUE(vals[0].get_allocator().arena());
+  EXPECT_EQ(vals[0].get_allocator().arena(), vals[1].get_allocator().arena());
+
+  const auto copy(var);
+  EXPECT_EQ(copy, var);
+  EXPECT_NE(copy.sparseValues<double>()[0].get_allocator().arena(),
+            vals[0].get_allocator().arena());
+}
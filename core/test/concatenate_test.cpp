@@ -212,6 +212,30 @@ TEST(ConcatenateTest, concatenate_sparse_no_data) {
   EXPECT_EQ(y.labels()["labs"], concatenate(var1, var2, Dim::Y));
 }
 
+TEST(ConcatenateTest, concatenate_sparse_float_data_and_int_labels) {
+  auto coord = makeVariable<double>(Dims{Dim::Y, Dim::X},
+                                    Shape{2, Dimensions::Sparse});
+  coord.sparseValues<double>()[0] = {1, 2};
+  auto data = makeVariable<float>(Dims{Dim::Y, Dim::X},
+                                  Shape{2, Dimensions::Sparse}, Values{},
+                                  Variances{});
+  data.sparseValues<float>()[0] = {3, 4};
+  data.sparseVariances<float>()[0] = {5, 6};
+  auto labels = makeVariable<int64_t>(Dims{Dim::Y, Dim::X},
+                                      Shape{2, Dimensions::Sparse});
+  labels.sparseValues<int64_t>()[0] = {7, 8};
+  const DataArray a(data, {{Dim::X, coord}}, {{"pulse", labels}});
+
+  const auto x = concatenate(a, a, Dim::X);
+
+  EXPECT_EQ(x.coords()[Dim::X], concatenate(coord, coord, Dim::X));
+  EXPECT_EQ(x.data(), concatenate(data, data, Dim::X));
+  EXPECT_TRUE(equals(x.values<sparse_container<float>>()[0], {3, 4, 3, 4}));
+  EXPECT_TRUE(equals(x.variances<sparse_container<float>>()[0], {5, 6, 5, 6}));
+  EXPECT_TRUE(equals(
+      x.labels()["pulse"].values<sparse_container<int64_t>>()[0], {7, 8, 7, 8}));
+}
+
 TEST(ConcatenateTest, dataset_with_no_data_items) {
   Dataset a, b;
   a.setCoord(Dim::X,
@@ -180,3 +180,30 @@ TEST(ElementArrayTest, resize_default_init) {
   x.resize(0, default_init_elements);
   check_empty_element_array(x);
 }
+
+TEST(ElementArrayTest, external_buffer) {
+  std::vector<double> buffer{1.0, 2.0, 3.0};
+  auto owner = std::make_shared<int>(0);
+  {
+    element_array<double> x(buffer.data(), 3, owner);
+    EXPECT_EQ(owner.use_count(), 2);
+    EXPECT_EQ(x.size(), 3);
+    EXPECT_EQ(x.data(), buffer.data());
+    x.data()[0] = 4.0;
+    EXPECT_EQ(buffer[0], 4.0);
+
+    const auto copy(x);
+    EXPECT_NE(copy.data(), buffer.data());
+    EXPECT_EQ(copy.data()[0], 4.0);
+  }
+  EXPECT_EQ(owner.use_count(), 1);
+}
+
+TEST(ElementArrayTest, external_buffer_released_on_resize) {
+  std::vector<double> buffer{1.0, 2.0, 3.0};
+  auto owner = std::make_shared<int>(0);
+  element_array<double> x(buffer.data(), 3, owner);
+  x.resize(2);
+  EXPECT_EQ(owner.use_count(), 1);
+  EXPECT_NE(x.data(), buffer.data());
+}
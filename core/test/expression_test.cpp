@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include "test_macros.h"
+
+#include "scipp/core/expression.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+class ExpressionTest : public ::testing::Test {
+protected:
+  Variable tof = makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{2, 3},
+                                      units::Unit(units::us),
+                                      Values{1, 2, 3, 4, 5, 6},
+                                      Variances{1, 1, 1, 2, 2, 2});
+  Variable tzero = makeVariable<double>(Values{0.5}, units::Unit(units::us));
+  Variable difc = makeVariable<double>(Dims{Dim::Y}, Shape{2},
+                                       units::Unit(units::us), Values{2, 4});
+};
+
+TEST_F(ExpressionTest, leaf) { EXPECT_EQ(eval(lazy(tof)), tof); }
+
+TEST_F(ExpressionTest, binary) {
+  EXPECT_EQ(eval(lazy(tof) + tzero), tof + tzero);
+  EXPECT_EQ(eval(lazy(tof) - tzero), tof - tzero);
+  EXPECT_EQ(eval(tof * lazy(difc)), tof * difc);
+  EXPECT_EQ(eval(lazy(tof) / lazy(difc)), tof / difc);
+}
+
+TEST_F(ExpressionTest, unary) {
+  EXPECT_EQ(eval(-lazy(tof)), -tof);
+  EXPECT_EQ(eval(sqrt(lazy(tof))), sqrt(tof));
+  EXPECT_EQ(eval(abs(-lazy(tof))), abs(-tof));
+  EXPECT_EQ(eval(reciprocal(lazy(difc))), reciprocal(difc));
+}
+
+TEST_F(ExpressionTest, chain_matches_eager) {
+  const Variable fused = (lazy(tof) - tzero) * reciprocal(lazy(difc));
+  EXPECT_EQ(fused, (tof - tzero) * reciprocal(difc));
+  EXPECT_EQ(fused.unit(), units::Unit(units::dimensionless));
+  EXPECT_EQ(eval(sqrt(lazy(tof) * tof) + difc / tzero - tof),
+            sqrt(tof * tof) + difc / tzero - tof);
+}
+
+TEST_F(ExpressionTest, float_inputs) {
+  const auto a = makeVariable<float>(Dims{Dim::X}, Shape{2},
+                                     units::Unit(units::m), Values{1, 4});
+  const auto b = makeVariable<float>(Dims{Dim::X}, Shape{2},
+                                     units::Unit(units::m), Values{2, 3});
+  EXPECT_EQ(eval(sqrt(lazy(a) * b) + a), sqrt(a * b) + a);
+}
+
+TEST_F(ExpressionTest, mixed_dtype_falls_back_to_eager) {
+  const auto f = makeVariable<float>(Values{2.0f}, units::Unit(units::us));
+  EXPECT_EQ(eval(lazy(tof) * f - tzero), tof * f - tzero);
+}
+
+TEST_F(ExpressionTest, sparse_falls_back_to_eager) {
+  auto sparse = makeVariable<double>(Dims{Dim::Y, Dim::X},
+                                     Shape{2, Dimensions::Sparse},
+                                     units::Unit(units::us));
+  sparse.sparseValues<double>()[0] = {1, 2};
+  sparse.sparseValues<double>()[1] = {3};
+  EXPECT_EQ(eval((lazy(sparse) - tzero) * reciprocal(lazy(difc))),
+            (sparse - tzero) * reciprocal(difc));
+}
+
+TEST_F(ExpressionTest, reduction) {
+  EXPECT_EQ(sum(lazy(tof) * difc, Dim::X), sum(tof * difc, Dim::X));
+  EXPECT_EQ(mean(lazy(tof) - tzero, Dim::Y), mean(tof - tzero, Dim::Y));
+}
+
+TEST_F(ExpressionTest, slice) {
+  EXPECT_EQ(eval(lazy(tof.slice({Dim::Y, 1})) * difc.slice({Dim::Y, 1})),
+            tof.slice({Dim::Y, 1}) * difc.slice({Dim::Y, 1}));
+}
+
+TEST_F(ExpressionTest, unit_mismatch) {
+  EXPECT_THROW(eval(lazy(tof) + difc * difc), except::UnitError);
+}
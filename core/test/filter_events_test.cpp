@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include "test_macros.h"
+
+#include "scipp/core/dataset.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+class FilterEventsTest : public ::testing::Test {
+protected:
+  static Variable make_coord(const std::vector<std::vector<double>> &lists) {
+    auto var = makeVariable<double>(
+        Dims{Dim::Y, Dim::X}, Shape{scipp::size(lists), Dimensions::Sparse},
+        units::Unit(units::us));
+    for (scipp::index i = 0; i < scipp::size(lists); ++i)
+      var.sparseValues<double>()[i].assign(lists[i].begin(), lists[i].end());
+    return var;
+  }
+
+  static DataArray make_array() {
+    auto data = makeVariable<float>(Dims{Dim::Y, Dim::X},
+                                    Shape{3l, Dimensions::Sparse},
+                                    units::Unit(units::counts), Values{},
+                                    Variances{});
+    data.sparseValues<float>()[0] = {1, 2, 3, 4};
+    data.sparseVariances<float>()[0] = {5, 6, 7, 8};
+    data.sparseValues<float>()[2] = {9, 10};
+    data.sparseVariances<float>()[2] = {11, 12};
+    auto labels = makeVariable<int64_t>(Dims{Dim::Y, Dim::X},
+                                        Shape{3l, Dimensions::Sparse});
+    labels.sparseValues<int64_t>()[0] = {10, 20, 30, 40};
+    labels.sparseValues<int64_t>()[2] = {50, 60};
+    return DataArray(data, {{Dim::X, make_coord({{4, 1, 3, 2}, {}, {0, 2}})}},
+                     {{"pulse", labels},
+                      {"dense", makeVariable<double>(Dims{Dim::Y}, Shape{3},
+                                                     Values{1, 2, 3})}});
+  }
+
+  Variable min = makeVariable<double>(Values{2.0}, units::Unit(units::us));
+  Variable max = makeVariable<double>(Values{4.0}, units::Unit(units::us));
+};
+
+TEST_F(FilterEventsTest, data_array) {
+  auto array = make_array();
+  filter_events(array, Dim::X, min, max);
+
+  EXPECT_EQ(array.coords()[Dim::X], make_coord({{3, 2}, {}, {2}}));
+  auto data = makeVariable<float>(Dims{Dim::Y, Dim::X},
+                                  Shape{3l, Dimensions::Sparse},
+                                  units::Unit(units::counts), Values{},
+                                  Variances{});
+  data.sparseValues<float>()[0] = {3, 4};
+  data.sparseVariances<float>()[0] = {7, 8};
+  data.sparseValues<float>()[2] = {10};
+  data.sparseVariances<float>()[2] = {12};
+  EXPECT_EQ(array.data(), data);
+  auto labels = makeVariable<int64_t>(Dims{Dim::Y, Dim::X},
+                                      Shape{3l, Dimensions::Sparse});
+  labels.sparseValues<int64_t>()[0] = {30, 40};
+  labels.sparseValues<int64_t>()[2] = {60};
+  EXPECT_EQ(array.labels()["pulse"], labels);
+  EXPECT_EQ(array.labels()["dense"], make_array().labels()["dense"]);
+}
+
+TEST_F(FilterEventsTest, does_not_modify_copies) {
+  auto array = make_array();
+  const auto original = array;
+  filter_events(array, Dim::X, min, max);
+  EXPECT_EQ(original, make_array());
+  EXPECT_NE(array, original);
+}
+
+TEST_F(FilterEventsTest, slice) {
+  auto array = make_array();
+  filter_events(DataProxy(array).slice({Dim::Y, 2}), Dim::X, min, max);
+  EXPECT_EQ(array.coords()[Dim::X], make_coord({{4, 1, 3, 2}, {}, {2}}));
+  EXPECT_TRUE(equals(array.labels()["pulse"].sparseValues<int64_t>()[0],
+                     {10, 20, 30, 40}));
+}
+
+TEST_F(FilterEventsTest, dataset) {
+  Dataset dataset;
+  dataset.setData("a", make_array());
+  dataset.setSparseCoord("b", make_coord({{1, 2}, {3}, {5}}));
+  filter_events(dataset, Dim::X, min, max);
+  EXPECT_EQ(dataset["a"].coords()[Dim::X], make_coord({{3, 2}, {}, {2}}));
+  EXPECT_EQ(dataset["b"].coords()[Dim::X], make_coord({{2}, {3}, {}}));
+}
+
+TEST_F(FilterEventsTest, fail_bad_interval) {
+  auto array = make_array();
+  EXPECT_THROW(filter_events(array, Dim::X, min,
+                             makeVariable<double>(Values{4.0},
+                                                  units::Unit(units::m))),
+               except::UnitError);
+  EXPECT_THROW(filter_events(array, Dim::X, min,
+                             makeVariable<float>(Values{4.0f},
+                                                 units::Unit(units::us))),
+               except::TypeError);
+  EXPECT_THROW(filter_events(array, Dim::X, min,
+                             makeVariable<double>(Dims{Dim::X}, Shape{1},
+                                                  units::Unit(units::us))),
+               except::DimensionMismatchError);
+}
+
+TEST_F(FilterEventsTest, fail_not_sparse_in_dim) {
+  auto array = make_array();
+  EXPECT_THROW(filter_events(array, Dim::Y, min, max), except::DimensionError);
+  DataArray dense(makeVariable<double>(Dims{Dim::X}, Shape{2}),
+                  {{Dim::X, makeVariable<double>(Dims{Dim::X}, Shape{2})}});
+  EXPECT_THROW(filter_events(dense, Dim::X, min, max), except::DimensionError);
+}
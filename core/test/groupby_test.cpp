@@ -2,7 +2,11 @@
 // Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
 #include <gtest/gtest.h>
 
+#include <map>
+#include <numeric>
+
 #include "scipp/core/groupby.h"
+#include "scipp/core/parallel.h"
 
 #include "test_macros.h"
 
@@ -548,3 +552,180 @@ TEST_F(GroupbyMinMaxTest, max) {
                                          units::Unit(units::m), Values{1, 3}));
   EXPECT_EQ(groupby(d, "labels2", Dim::Y).max(Dim::X), expected);
 }
+
+template <class T> struct GroupbyKeyTest : public ::testing::Test {
+  /// Check grouping `keys` against std::map, counting elements in each group.
+  static void check(const std::vector<T> &keys) {
+    std::map<T, double> counts;
+    for (const auto &key : keys)
+      counts[key] += 1.0;
+    std::vector<T> expected_keys;
+    std::vector<double> expected_counts;
+    for (const auto &[key, count] : counts) {
+      expected_keys.push_back(key);
+      expected_counts.push_back(count);
+    }
+    const auto size = scipp::size(keys);
+    DataArray a(
+        makeVariable<double>(Dims{Dim::X}, Shape{size},
+                             Values(std::vector<double>(keys.size(), 1.0))),
+        {},
+        {{"key",
+          makeVariable<T>(Dims{Dim::X}, Shape{size}, units::Unit(units::m),
+                          Values(keys))}});
+    DataArray expected(
+        makeVariable<double>(Dims{Dim::Y}, Shape{scipp::size(counts)},
+                             Values(expected_counts)),
+        {{Dim::Y, makeVariable<T>(Dims{Dim::Y}, Shape{scipp::size(counts)},
+                                  units::Unit(units::m),
+                                  Values(expected_keys))}});
+    EXPECT_EQ(groupby(a, "key", Dim::Y).sum(Dim::X), expected);
+  }
+};
+
+using GroupbyKeyTypes =
+    ::testing::Types<double, float, int64_t, int32_t, std::string>;
+TYPED_TEST_SUITE(GroupbyKeyTest, GroupbyKeyTypes);
+
+template <class T> T make_key(const int64_t i) {
+  if constexpr (std::is_same_v<T, std::string>)
+    return std::to_string(i);
+  else
+    return static_cast<T>(i);
+}
+
+TYPED_TEST(GroupbyKeyTest, few_distinct_small_range) {
+  std::vector<TypeParam> keys;
+  for (int64_t i = 0; i < 10000; ++i)
+    keys.push_back(make_key<TypeParam>((i * 7) % 13 - 6));
+  this->check(keys);
+}
+
+TYPED_TEST(GroupbyKeyTest, few_distinct_large_range) {
+  std::vector<TypeParam> keys;
+  for (int64_t i = 0; i < 10000; ++i)
+    keys.push_back(make_key<TypeParam>(((i * 7) % 13) * 100000000 - 600000000));
+  this->check(keys);
+}
+
+TYPED_TEST(GroupbyKeyTest, many_distinct) {
+  std::vector<TypeParam> keys;
+  for (int64_t i = 0; i < 10000; ++i)
+    keys.push_back(make_key<TypeParam>(((i * 7919) % 10007) * 100000));
+  this->check(keys);
+}
+
+TYPED_TEST(GroupbyKeyTest, contiguous_runs) {
+  std::vector<TypeParam> keys;
+  for (int64_t i = 0; i < 10000; ++i)
+    keys.push_back(make_key<TypeParam>((i / 100) % 7));
+  this->check(keys);
+}
+
+TEST(GroupbyKeyTest, bool_key) {
+  GroupbyKeyTest<bool>::check({true, false, false, true, true, false, true});
+}
+
+TEST(GroupbyKeyTest, negative_zero) {
+  DataArray a(makeVariable<double>(Dims{Dim::X}, Shape{4}, Values{1, 2, 3, 4}),
+              {},
+              {{"key", makeVariable<double>(Dims{Dim::X}, Shape{4},
+                                            Values{0.0, 1.0, -0.0, 0.0})}});
+  const auto grouped = groupby(a, "key", Dim::Y).sum(Dim::X);
+  EXPECT_EQ(grouped.coords()[Dim::Y],
+            makeVariable<double>(Dims{Dim::Y}, Shape{2}, Values{0.0, 1.0}));
+  EXPECT_EQ(grouped.data(),
+            makeVariable<double>(Dims{Dim::Y}, Shape{2}, Values{8.0, 2.0}));
+}
+
+struct GroupbyManyGroupsTest : public ::testing::Test {
+  // Use multiple threads also on machines with few cores.
+  GroupbyManyGroupsTest() { parallel::set_max_threads(4); }
+  ~GroupbyManyGroupsTest() { parallel::set_max_threads(0); }
+
+  static constexpr scipp::index rows = 100000;
+  static constexpr scipp::index n_groups = 1000;
+
+  DataArray make_dense() const {
+    std::vector<double> values(rows * 2);
+    std::iota(values.begin(), values.end(), 0.0);
+    std::vector<int64_t> keys(rows);
+    for (scipp::index i = 0; i < rows; ++i)
+      keys[i] = (i * 7) % n_groups;
+    return DataArray(
+        makeVariable<double>(Dims{Dim::X, Dim::Z}, Shape{rows, 2l},
+                             units::Unit(units::counts), Values(values),
+                             Variances(values)),
+        {}, {{"key", makeVariable<int64_t>(Dims{Dim::X}, Shape{rows},
+                                           Values(keys))}});
+  }
+
+  DataArray make_expected_sum(const std::vector<bool> &masked = {}) const {
+    std::vector<double> sums(n_groups * 2);
+    for (scipp::index i = 0; i < rows; ++i)
+      if (masked.empty() || !masked[i])
+        for (scipp::index z = 0; z < 2; ++z)
+          sums[((i * 7) % n_groups) * 2 + z] += i * 2 + z;
+    std::vector<int64_t> keys(n_groups);
+    std::iota(keys.begin(), keys.end(), 0);
+    return DataArray(
+        makeVariable<double>(Dims{Dim::Y, Dim::Z}, Shape{n_groups, 2l},
+                             units::Unit(units::counts), Values(sums),
+                             Variances(sums)),
+        {{Dim::Y, makeVariable<int64_t>(Dims{Dim::Y}, Shape{n_groups},
+                                        Values(keys))}});
+  }
+};
+
+TEST_F(GroupbyManyGroupsTest, sum) {
+  EXPECT_EQ(groupby(make_dense(), "key", Dim::Y).sum(Dim::X),
+            make_expected_sum());
+}
+
+TEST_F(GroupbyManyGroupsTest, sum_masked) {
+  auto a = make_dense();
+  std::vector<bool> masked(rows);
+  auto mask = makeVariable<bool>(Dims{Dim::X}, Shape{rows});
+  for (scipp::index i = 0; i < rows; ++i)
+    mask.values<bool>()[i] = masked[i] = i % 3 == 0;
+  a.masks().set("mask", mask);
+  const auto summed = groupby(a, "key", Dim::Y).sum(Dim::X);
+  EXPECT_EQ(summed.data(), make_expected_sum(masked).data());
+}
+
+TEST_F(GroupbyManyGroupsTest, sum_dataset) {
+  Dataset d;
+  d.setData("a", make_dense());
+  d.setData("b", make_dense().data().slice({Dim::Z, 1}));
+  const auto summed = groupby(d, "key", Dim::Y).sum(Dim::X);
+  const auto expected = make_expected_sum();
+  EXPECT_EQ(summed["a"], expected);
+  EXPECT_EQ(summed["b"].data(), expected.data().slice({Dim::Z, 1}));
+}
+
+TEST_F(GroupbyManyGroupsTest, max_matches_single_thread) {
+  const auto a = make_dense();
+  const auto result = groupby(a, "key", Dim::Y).max(Dim::X);
+  parallel::set_max_threads(1);
+  EXPECT_EQ(result, groupby(a, "key", Dim::Y).max(Dim::X));
+}
+
+TEST_F(GroupbyManyGroupsTest, flatten_matches_single_thread) {
+  const scipp::index size = 10000;
+  auto var = makeVariable<double>(Dims{Dim::Y, Dim::X},
+                                  Shape{size, Dimensions::Sparse});
+  const auto &var_ = var.sparseValues<double>();
+  std::vector<double> keys(size);
+  for (scipp::index i = 0; i < size; ++i) {
+    var_[i] = {1.0 * i, 2.0 * i};
+    keys[i] = i % 100;
+  }
+  DataArray a{var * 1.5,
+              {{Dim::X, var}},
+              {{"labels",
+                makeVariable<double>(Dims{Dim::Y}, Shape{size}, Values(keys))}}};
+
+  const auto result = groupby(a, "labels", Dim::Z).flatten(Dim::Y);
+  parallel::set_max_threads(1);
+  EXPECT_EQ(result, groupby(a, "labels", Dim::Z).flatten(Dim::Y));
+}
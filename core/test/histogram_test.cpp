@@ -6,6 +6,7 @@
 
 #include "scipp/core/dataset.h"
 #include "scipp/core/histogram.h"
+#include "scipp/core/parallel.h"
 
 using namespace scipp;
 using namespace scipp::core;
@@ -191,3 +192,175 @@ TEST(HistogramTest, dataset_own_coord) {
   sparse.setCoord(Dim::Y, coord);
   EXPECT_EQ(core::histogram(sparse, Dim::Y), expected);
 }
+
+TEST(HistogramTest, sorted_events_non_linear_edges) {
+  auto sorted = make_2d_sparse_coord_only("sparse");
+  sorted["sparse"].coords()[Dim::Y].sparseValues<double>()[1] = {
+      3.5, 4.5, 5.5, 6.5, 7.5, NAN};
+  auto unsorted = make_2d_sparse_coord_only("sparse");
+  auto coord = unsorted["sparse"].coords()[Dim::Y];
+  coord.sparseValues<double>()[0] = {5.5, 1.5, 4.5, 2.5, 3.5};
+  coord.sparseValues<double>()[1] = {7.5, 3.5, NAN, 6.5, 5.5, 4.5};
+  coord.sparseValues<double>()[2] = {4, 2, -1, 6, 0, 1, 4, 2, 0, 1, 2, 4};
+  const auto edges =
+      makeVariable<double>(Dims{Dim::Y}, Shape{5}, Values{0, 1, 2, 4, 5.5});
+  std::vector<double> ref{0, 1, 2, 1, 0, 0, 1, 1, 2, 2, 3, 3};
+  const auto expected = make_expected(
+      makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{3, 4},
+                           units::Unit(units::counts),
+                           Values(ref.begin(), ref.end()),
+                           Variances(ref.begin(), ref.end())),
+      edges);
+
+  EXPECT_EQ(core::histogram(sorted["sparse"], edges), expected);
+  EXPECT_EQ(core::histogram(unsorted["sparse"], edges), expected);
+}
+
+TEST(HistogramTest, sorted_events_non_linear_edges_with_data) {
+  auto sparse = make_2d_sparse_coord_only("sparse");
+  auto data = makeVariable<double>(
+      Dimensions{{Dim::X, 3}, {Dim::Y, Dimensions::Sparse}},
+      units::Unit(units::counts), Values{}, Variances{});
+  for (scipp::index i = 0; i < 3; ++i) {
+    const auto size =
+        scipp::size(sparse["sparse"].coords()[Dim::Y].sparseValues<double>()[i]);
+    data.sparseValues<double>()[i].assign(size, 2.0);
+    data.sparseVariances<double>()[i].assign(size, 3.0);
+  }
+  sparse.setData("sparse", data);
+  const auto edges =
+      makeVariable<double>(Dims{Dim::Y}, Shape{5}, Values{0, 1, 2, 4, 5.5});
+  std::vector<double> ref{0, 1, 2, 1, 0, 0, 1, 1, 2, 2, 3, 3};
+  auto values = ref;
+  auto variances = ref;
+  for (auto &x : values)
+    x *= 2.0;
+  for (auto &x : variances)
+    x *= 3.0;
+  const auto expected = make_expected(
+      makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{3, 4},
+                           units::Unit(units::counts),
+                           Values(values.begin(), values.end()),
+                           Variances(variances.begin(), variances.end())),
+      edges);
+
+  EXPECT_EQ(core::histogram(sparse["sparse"], edges), expected);
+}
+
+TEST(HistogramTest, linear_edges_many_events_per_bin) {
+  // Enough events per bin to accumulate into interleaved histograms, with
+  // events below, above, and on the edges, and NaN.
+  Dataset sparse;
+  sparse.setSparseCoord("double", makeVariable<double>(
+                                      Dims{Dim::X}, Shape{Dimensions::Sparse}));
+  sparse.setSparseCoord("float", makeVariable<float>(
+                                     Dims{Dim::X}, Shape{Dimensions::Sparse}));
+  auto &events = sparse["double"].coords()[Dim::X].sparseValues<double>()[0];
+  auto &floats = sparse["float"].coords()[Dim::X].sparseValues<float>()[0];
+  const std::vector<double> cycle{-0.5, 0.0, 0.5, 1.0, 2.5, 2.5, 3.0, 3.5, NAN};
+  for (scipp::index i = 0; i < 1000; ++i)
+    for (const auto x : cycle) {
+      events.push_back(x);
+      floats.push_back(static_cast<float>(x));
+    }
+  const auto edges =
+      makeVariable<double>(Dims{Dim::X}, Shape{4}, Values{0.0, 1.0, 2.0, 3.0});
+  const auto hist = core::histogram(sparse, edges);
+  const auto expected = makeVariable<double>(
+      Dims{Dim::X}, Shape{3}, units::Unit(units::counts),
+      Values{2000, 1000, 2000}, Variances{2000, 1000, 2000});
+  EXPECT_EQ(hist["double"].data(), expected);
+  EXPECT_EQ(hist["float"].data(), expected);
+}
+
+class HistogramParallelTest : public ::testing::Test {
+protected:
+  // Use multiple threads also on machines with few cores.
+  HistogramParallelTest() { parallel::set_max_threads(4); }
+  ~HistogramParallelTest() override { parallel::set_max_threads(0); }
+
+  // Events 0.5, 1.5, ..., 9.5, repeated, i.e., spread evenly over 10 bins.
+  static Dataset make_events(const scipp::index n_spectra,
+                             const scipp::index n_events) {
+    Dataset sparse;
+    auto var = makeVariable<double>(Dims{Dim::X, Dim::Y},
+                                    Shape{n_spectra, Dimensions::Sparse});
+    auto data = makeVariable<double>(Dims{Dim::X, Dim::Y},
+                                     Shape{n_spectra, Dimensions::Sparse},
+                                     Values{}, Variances{});
+    for (scipp::index i = 0; i < n_spectra; ++i) {
+      auto &events = var.sparseValues<double>()[i];
+      auto &weights = data.sparseValues<double>()[i];
+      auto &variances = data.sparseVariances<double>()[i];
+      for (scipp::index j = 0; j < n_events; ++j) {
+        events.push_back(j % 10 + 0.5);
+        weights.push_back(2.0);
+        variances.push_back(3.0);
+      }
+    }
+    data.setUnit(units::counts);
+    sparse.setSparseCoord("unweighted", var);
+    sparse.setSparseCoord("weighted", var);
+    sparse.setData("weighted", data);
+    return sparse;
+  }
+
+  static void expect_serial_equal(const Dataset &sparse,
+                                  const Variable &edges) {
+    const auto hist = core::histogram(sparse, edges);
+    parallel::set_max_threads(1);
+    const auto serial = core::histogram(sparse, edges);
+    parallel::set_max_threads(4);
+    EXPECT_EQ(hist, serial);
+  }
+};
+
+TEST_F(HistogramParallelTest, single_large_event_list) {
+  const scipp::index n_events = 1000000;
+  const auto sparse = make_events(1, n_events);
+  const auto edges = makeVariable<double>(
+      Dims{Dim::Y}, Shape{11}, Values{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+  const auto hist = core::histogram(sparse, edges);
+  const auto counts = hist["unweighted"].values<double>();
+  const auto weighted = hist["weighted"].values<double>();
+  const auto variances = hist["weighted"].variances<double>();
+  for (scipp::index bin = 0; bin < 10; ++bin) {
+    EXPECT_EQ(counts[bin], n_events / 10);
+    EXPECT_EQ(weighted[bin], 2.0 * n_events / 10);
+    EXPECT_EQ(variances[bin], 3.0 * n_events / 10);
+  }
+  expect_serial_equal(sparse, edges);
+}
+
+TEST_F(HistogramParallelTest, single_large_event_list_non_linear_edges) {
+  const auto sparse = make_events(1, 1000000);
+  expect_serial_equal(sparse, makeVariable<double>(Dims{Dim::Y}, Shape{5},
+                                                   Values{0, 1, 2, 4, 10}));
+}
+
+TEST_F(HistogramParallelTest,
+       single_large_sorted_event_list_non_linear_edges) {
+  const scipp::index n_events = 1000000;
+  auto sparse = make_events(1, n_events);
+  for (const auto &name : {"unweighted", "weighted"}) {
+    auto &events = sparse[name].coords()[Dim::Y].sparseValues<double>()[0];
+    std::sort(events.begin(), events.end());
+  }
+  const auto edges =
+      makeVariable<double>(Dims{Dim::Y}, Shape{5}, Values{0, 1, 2, 4, 10});
+  const auto hist = core::histogram(sparse, edges);
+  const std::vector<double> events_per_bin{1, 1, 2, 6};
+  for (scipp::index bin = 0; bin < 4; ++bin) {
+    const auto n = events_per_bin[bin] * n_events / 10;
+    EXPECT_EQ(hist["unweighted"].values<double>()[bin], n);
+    EXPECT_EQ(hist["weighted"].values<double>()[bin], 2.0 * n);
+    EXPECT_EQ(hist["weighted"].variances<double>()[bin], 3.0 * n);
+  }
+  expect_serial_equal(sparse, edges);
+}
+
+TEST_F(HistogramParallelTest, many_spectra) {
+  const auto sparse = make_events(1000, 100);
+  expect_serial_equal(sparse, makeVariable<double>(Dims{Dim::Y}, Shape{4},
+                                                   Values{0, 1, 3, 9}));
+}
@@ -4,6 +4,7 @@
 
 #include "test_macros.h"
 
+#include "scipp/core/dataset.h"
 #include "scipp/core/indexed_slice_view.h"
 #include "scipp/core/variable.h"
 
@@ -30,3 +31,58 @@ TEST(IndexedSliceViewTest, variable) {
   EXPECT_EQ(*begin++, var.slice({Dim::X, 1, 2}));
   EXPECT_EQ(begin, view.end());
 }
+
+TEST(IndexedSliceViewTest, concatenate_variable) {
+  const auto var = makeVariable<double>(
+      Dims{Dim::Y, Dim::X}, Shape{2, 4}, units::Unit(units::m),
+      Values{1, 2, 3, 4, 5, 6, 7, 8}, Variances{9, 10, 11, 12, 13, 14, 15, 16});
+  EXPECT_EQ(concatenate(IndexedSliceView{var, Dim::X, {2, 2, 0, 3, 1}}),
+            makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{2, 5},
+                                 units::Unit(units::m),
+                                 Values{3, 3, 1, 4, 2, 7, 7, 5, 8, 6},
+                                 Variances{11, 11, 9, 12, 10, 15, 15, 13, 16,
+                                           14}));
+  EXPECT_EQ(concatenate(IndexedSliceView{var, Dim::X, {1, 2, 3, 0}}),
+            makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{2, 4},
+                                 units::Unit(units::m),
+                                 Values{2, 3, 4, 1, 6, 7, 8, 5},
+                                 Variances{10, 11, 12, 9, 14, 15, 16, 13}));
+  EXPECT_EQ(concatenate(IndexedSliceView{var, Dim::Y, {1}}),
+            var.slice({Dim::Y, 1, 2}));
+  EXPECT_EQ(concatenate(IndexedSliceView{var, Dim::X, {}}),
+            var.slice({Dim::X, 0, 0}));
+}
+
+TEST(IndexedSliceViewTest, concatenate_data_array) {
+  const auto data =
+      makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{1, 2, 3});
+  const auto x = makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{4, 5, 6});
+  const auto y = makeVariable<double>(Dims{Dim::Y}, Shape{2}, Values{7, 8});
+  const auto mask =
+      makeVariable<bool>(Dims{Dim::X}, Shape{3}, Values{true, false, false});
+  const DataArray a(data, {{Dim::X, x}, {Dim::Y, y}}, {{"label", x}},
+                    {{"mask", mask}});
+
+  const DataArray expected(
+      makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{3, 1, 1}),
+      {{Dim::X, makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{6, 4, 4})},
+       {Dim::Y, y}},
+      {{"label",
+        makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{6, 4, 4})}},
+      {{"mask", makeVariable<bool>(Dims{Dim::X}, Shape{3},
+                                   Values{false, true, true})}});
+  EXPECT_EQ(concatenate(IndexedSliceView{a, Dim::X, {2, 0, 0}}), expected);
+}
+
+TEST(IndexedSliceViewTest, concatenate_bin_edges) {
+  const auto data =
+      makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{1, 2, 3});
+  const auto edges =
+      makeVariable<double>(Dims{Dim::X}, Shape{4}, Values{4, 5, 6, 7});
+  const DataArray a(data, {{Dim::X, edges}});
+
+  EXPECT_EQ(concatenate(IndexedSliceView{a, Dim::X, {1, 2}}),
+            a.slice({Dim::X, 1, 3}));
+  EXPECT_THROW(concatenate(IndexedSliceView{a, Dim::X, {1, 0}}),
+               except::VariableMismatchError);
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+
+#include "scipp/core/element_array.h"
+#include "scipp/core/memory_pool.h"
+
+using namespace scipp;
+using namespace scipp::core;
+using scipp::core::detail::element_array;
+
+class MemoryPoolTest : public ::testing::Test {
+protected:
+  MemoryPoolTest() { MemoryPool::local()->release(); }
+  ~MemoryPoolTest() {
+    MemoryPool::set_max_cached_bytes(limit);
+    MemoryPool::local()->release();
+  }
+  const std::size_t limit = MemoryPool::max_cached_bytes();
+};
+
+TEST_F(MemoryPoolTest, size_class) {
+  EXPECT_EQ(MemoryPool::size_class(1), 0);
+  EXPECT_EQ(MemoryPool::size_class(64), 0);
+  EXPECT_EQ(MemoryPool::class_size(0), 64);
+  std::size_t previous = 0;
+  for (std::size_t size = 1; size < 100000; size += 7) {
+    const auto index = MemoryPool::size_class(size);
+    const auto bytes = MemoryPool::class_size(index);
+    EXPECT_GE(index, previous);
+    EXPECT_GE(bytes, size);
+    EXPECT_LE(bytes, std::max<std::size_t>(64, size + size / 4));
+    EXPECT_EQ(MemoryPool::size_class(bytes), index);
+    previous = index;
+  }
+}
+
+TEST_F(MemoryPoolTest, allocate_aligned) {
+  auto *ptr = pool_allocate(100);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % MemoryPool::alignment, 0);
+  pool_deallocate(ptr, 100);
+}
+
+TEST_F(MemoryPoolTest, reuse_freed_block) {
+  auto &pool = *MemoryPool::local();
+  auto *ptr = pool_allocate(100000);
+  pool_deallocate(ptr, 100000);
+  EXPECT_EQ(pool.cached_bytes(),
+            MemoryPool::class_size(MemoryPool::size_class(100000)));
+  EXPECT_EQ(pool_allocate(99999), ptr);
+  EXPECT_EQ(pool.cached_bytes(), 0);
+  pool_deallocate(ptr, 99999);
+}
+
+TEST_F(MemoryPoolTest, max_cached_bytes) {
+  auto &pool = *MemoryPool::local();
+  MemoryPool::set_max_cached_bytes(1000);
+  auto *a = pool_allocate(640);
+  auto *b = pool_allocate(640);
+  pool_deallocate(a, 640);
+  pool_deallocate(b, 640);
+  EXPECT_EQ(pool.cached_bytes(), 640);
+  pool.release();
+  EXPECT_EQ(pool.cached_bytes(), 0);
+}
+
+TEST_F(MemoryPoolTest, deallocate_in_other_thread) {
+  auto *ptr = pool_allocate(1000);
+  std::thread([ptr]() { pool_deallocate(ptr, 1000); }).join();
+  EXPECT_EQ(MemoryPool::local()->cached_bytes(), 0);
+}
+
+TEST_F(MemoryPoolTest, element_array_reuses_buffer) {
+  const double *data = nullptr;
+  {
+    element_array<double> x(10000, 1.0);
+    data = x.data();
+  }
+  element_array<double> y(10000);
+  EXPECT_EQ(y.data(), data);
+  for (const auto &value : y)
+    EXPECT_EQ(value, 0.0);
+}
+
+TEST_F(MemoryPoolTest, element_array_non_trivial) {
+  const element_array<std::string> x(3, std::string(100, 'a'));
+  auto y = x;
+  y.resize(2);
+  EXPECT_EQ(x.data()[2], std::string(100, 'a'));
+  EXPECT_EQ(y.data()[1], "");
+}
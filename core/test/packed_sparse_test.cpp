@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include "test_macros.h"
+
+#include "scipp/core/packed_sparse.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+class PackedSparseTest : public ::testing::Test {
+protected:
+  Variable sparse = [] {
+    auto var = makeVariable<double>(Dims{Dim::Y, Dim::X},
+                                    Shape{3l, Dimensions::Sparse},
+                                    units::Unit(units::us), Values{},
+                                    Variances{});
+    var.sparseValues<double>()[0] = {1, 2, 3};
+    var.sparseValues<double>()[2] = {4, 5};
+    var.sparseVariances<double>()[0] = {6, 7, 8};
+    var.sparseVariances<double>()[2] = {9, 10};
+    return var;
+  }();
+};
+
+TEST_F(PackedSparseTest, fail_dense) {
+  EXPECT_THROW(PackedSparse(makeVariable<double>(Dims{Dim::X}, Shape{2})),
+               except::DimensionError);
+}
+
+TEST_F(PackedSparseTest, pack) {
+  const PackedSparse packed(sparse);
+  EXPECT_EQ(packed.dims(), sparse.dims());
+  EXPECT_EQ(packed.unit(), units::us);
+  EXPECT_EQ(packed.dtype(), dtype<double>);
+  EXPECT_TRUE(packed.hasVariances());
+  EXPECT_EQ(packed.size(), 5);
+  EXPECT_TRUE(equals(packed.offsets(), {0, 3, 3, 5}));
+  EXPECT_EQ(packed.buffer(),
+            makeVariable<double>(Dims{Dim::X}, Shape{5},
+                                 units::Unit(units::us),
+                                 Values{1, 2, 3, 4, 5},
+                                 Variances{6, 7, 8, 9, 10}));
+}
+
+TEST_F(PackedSparseTest, pack_slice) {
+  const PackedSparse packed(sparse.slice({Dim::Y, 1, 3}));
+  EXPECT_TRUE(equals(packed.offsets(), {0, 0, 2}));
+  EXPECT_EQ(packed.unpack(), sparse.slice({Dim::Y, 1, 3}));
+}
+
+TEST_F(PackedSparseTest, unpack) {
+  EXPECT_EQ(PackedSparse(sparse).unpack(), sparse);
+  auto ints = makeVariable<int32_t>(Dims{Dim::Y, Dim::X},
+                                    Shape{2l, Dimensions::Sparse});
+  ints.sparseValues<int32_t>()[1] = {1, 2};
+  EXPECT_EQ(PackedSparse(ints).unpack(), ints);
+}
+
+TEST_F(PackedSparseTest, from_buffer) {
+  const PackedSparse packed(
+      sparse.dims(), {0, 3, 3, 5},
+      makeVariable<double>(Dims{Dim::X}, Shape{5}, units::Unit(units::us),
+                           Values{1, 2, 3, 4, 5}, Variances{6, 7, 8, 9, 10}));
+  EXPECT_EQ(packed.unpack(), sparse);
+}
+
+TEST_F(PackedSparseTest, from_buffer_bad_offsets) {
+  const auto buffer = makeVariable<double>(Dims{Dim::X}, Shape{5});
+  EXPECT_THROW(PackedSparse(sparse.dims(), {0, 3, 5}, buffer),
+               except::SizeError);
+  EXPECT_THROW(PackedSparse(sparse.dims(), {1, 3, 3, 5}, buffer),
+               except::SizeError);
+  EXPECT_THROW(PackedSparse(sparse.dims(), {0, 3, 2, 5}, buffer),
+               except::SizeError);
+  EXPECT_THROW(PackedSparse(sparse.dims(), {0, 3, 3, 4}, buffer),
+               except::DimensionMismatchError);
+}
+
+TEST_F(PackedSparseTest, from_buffer_bad_dims) {
+  EXPECT_THROW(PackedSparse(Dimensions(Dim::X, 5), {0, 5},
+                            makeVariable<double>(Dims{Dim::X}, Shape{5})),
+               except::DimensionError);
+  EXPECT_THROW(PackedSparse(sparse.dims(), {0, 3, 3, 5},
+                            makeVariable<double>(Dims{Dim::Y}, Shape{5})),
+               except::DimensionMismatchError);
+}
+
+TEST_F(PackedSparseTest, view) {
+  PackedSparse packed(sparse);
+  const auto view = packed.view();
+  EXPECT_EQ(view.dims(), Dimensions({Dim::Y, 3}));
+  EXPECT_EQ(view.unit(), units::us);
+  EXPECT_TRUE(equals(view.values<span<double>>()[0], {1, 2, 3}));
+  EXPECT_TRUE(view.values<span<double>>()[1].empty());
+  EXPECT_TRUE(equals(view.values<span<double>>()[2], {4, 5}));
+  EXPECT_TRUE(equals(view.variances<span<double>>()[2], {9, 10}));
+}
+
+TEST_F(PackedSparseTest, view_of_const) {
+  const PackedSparse packed(sparse);
+  EXPECT_TRUE(equals(packed.view().values<span<const double>>()[2], {4, 5}));
+}
+
+TEST_F(PackedSparseTest, view_modifies_buffer) {
+  PackedSparse packed(sparse);
+  auto view = packed.view();
+  for (const auto &events : view.values<span<double>>())
+    for (auto &event : events)
+      event *= 2.0;
+  for (const auto &events : view.variances<span<double>>())
+    for (auto &event : events)
+      event *= 4.0;
+  EXPECT_EQ(packed.unpack(), sparse * 2.0);
+}
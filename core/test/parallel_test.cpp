@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "scipp/core/parallel.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+TEST(ParallelTest, blocked_range) {
+  const parallel::blocked_range range(2, 7, 0);
+  EXPECT_EQ(range.begin(), 2);
+  EXPECT_EQ(range.end(), 7);
+  EXPECT_EQ(range.size(), 5);
+  EXPECT_EQ(range.grainsize(), 1);
+  EXPECT_FALSE(range.empty());
+  EXPECT_TRUE(parallel::blocked_range(3, 3).empty());
+}
+
+TEST(ParallelTest, parallel_for_visits_every_index_once) {
+  std::vector<std::atomic<int>> visits(1000);
+  parallel::parallel_for(parallel::blocked_range(0, 1000, 10),
+                         [&](const auto &range) {
+                           for (auto i = range.begin(); i < range.end(); ++i)
+                             ++visits[i];
+                         });
+  for (const auto &count : visits)
+    ASSERT_EQ(count, 1);
+}
+
+TEST(ParallelTest, parallel_for_chunks_respect_grainsize) {
+  std::atomic<scipp::index> min_size{1000};
+  parallel::parallel_for(parallel::blocked_range(0, 1000, 100),
+                         [&](const auto &range) {
+                           auto current = min_size.load();
+                           while (range.size() < current &&
+                                  !min_size.compare_exchange_weak(current,
+                                                                  range.size()))
+                             ;
+                         });
+  EXPECT_GE(min_size, 100);
+}
+
+TEST(ParallelTest, parallel_for_nested_is_serial) {
+  std::atomic<int> inner_calls{0};
+  parallel::parallel_for(parallel::blocked_range(0, 4), [&](const auto &outer) {
+    for (auto i = outer.begin(); i < outer.end(); ++i)
+      parallel::parallel_for(parallel::blocked_range(0, 1000),
+                             [&](const auto &range) {
+                               EXPECT_EQ(range.size(), 1000);
+                               ++inner_calls;
+                             });
+  });
+  EXPECT_EQ(inner_calls, 4);
+}
+
+TEST(ParallelTest, parallel_for_rethrows) {
+  EXPECT_THROW(parallel::parallel_for(parallel::blocked_range(0, 100),
+                                      [](const auto &range) {
+                                        if (range.begin() == 0)
+                                          throw std::runtime_error("fail");
+                                      }),
+               std::runtime_error);
+}
+
+class ParallelThreadsTest : public ::testing::Test {
+protected:
+  ~ParallelThreadsTest() override { parallel::set_max_threads(0); }
+
+  auto thread_ids(const scipp::index size) {
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+    parallel::parallel_for(parallel::blocked_range(0, size),
+                           [&](const auto &) {
+                             std::lock_guard lock(mutex);
+                             ids.insert(std::this_thread::get_id());
+                           });
+    return ids;
+  }
+};
+
+TEST_F(ParallelThreadsTest, max_threads) {
+  parallel::set_max_threads(3);
+  EXPECT_EQ(parallel::max_threads(), 3);
+  parallel::set_max_threads(0);
+  const auto hardware =
+      static_cast<scipp::index>(std::thread::hardware_concurrency());
+  EXPECT_EQ(parallel::max_threads(), std::max(scipp::index{1}, hardware));
+  EXPECT_THROW(parallel::set_max_threads(-1), std::invalid_argument);
+}
+
+TEST_F(ParallelThreadsTest, single_thread_runs_in_calling_thread) {
+  parallel::set_max_threads(1);
+  const auto ids = thread_ids(100);
+  ASSERT_EQ(ids.size(), 1);
+  EXPECT_EQ(*ids.begin(), std::this_thread::get_id());
+}
+
+TEST_F(ParallelThreadsTest, pool_limited_by_max_threads) {
+  parallel::set_max_threads(4);
+  for (scipp::index i = 0; i < 10; ++i)
+    EXPECT_LE(thread_ids(100).size(), 4);
+  parallel::set_max_threads(2);
+  for (scipp::index i = 0; i < 10; ++i)
+    EXPECT_LE(thread_ids(100).size(), 2);
+}
+
+TEST_F(ParallelThreadsTest, pool_visits_every_index_once) {
+  parallel::set_max_threads(4);
+  std::vector<std::atomic<int>> visits(1000);
+  for (scipp::index repeat = 0; repeat < 10; ++repeat)
+    parallel::parallel_for(parallel::blocked_range(0, 1000),
+                           [&](const auto &range) {
+                             for (auto i = range.begin(); i < range.end(); ++i)
+                               ++visits[i];
+                           });
+  for (const auto &count : visits)
+    ASSERT_EQ(count, 10);
+}
+
+TEST_F(ParallelThreadsTest, pool_rethrows) {
+  parallel::set_max_threads(4);
+  EXPECT_THROW(parallel::parallel_for(parallel::blocked_range(0, 100),
+                                      [](const auto &range) {
+                                        if (range.begin() != 0)
+                                          throw std::runtime_error("fail");
+                                      }),
+               std::runtime_error);
+  // Pool is still functional after a failure.
+  EXPECT_LE(thread_ids(100).size(), 4);
+}
+
+TEST_F(ParallelThreadsTest, concurrent_callers) {
+  parallel::set_max_threads(4);
+  std::atomic<scipp::index> total{0};
+  const auto run = [&]() {
+    for (scipp::index repeat = 0; repeat < 100; ++repeat)
+      parallel::parallel_for(parallel::blocked_range(0, 100),
+                             [&](const auto &range) { total += range.size(); });
+  };
+  std::thread other(run);
+  run();
+  other.join();
+  EXPECT_EQ(total, 2 * 100 * 100);
+}
+
+TEST(ParallelTest, grainsize) {
+  EXPECT_EQ(parallel::grainsize(), parallel::default_grainsize);
+  parallel::set_grainsize(10);
+  EXPECT_EQ(parallel::grainsize(), 10);
+  EXPECT_THROW(parallel::set_grainsize(0), std::invalid_argument);
+  EXPECT_EQ(parallel::grainsize(), 10);
+  parallel::set_grainsize(parallel::default_grainsize);
+}
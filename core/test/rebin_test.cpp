@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include "scipp/core/dataset.h"
+#include "scipp/core/parallel.h"
 
 using namespace scipp;
 using namespace scipp::core;
@@ -176,3 +177,84 @@ TEST_F(RebinMask2DTest, mask_weights_2d) {
 
   ASSERT_EQ(result, expected);
 }
+
+class RebinLargeTest : public ::testing::Test {
+protected:
+  // Use multiple threads also on machines with few cores.
+  RebinLargeTest() { parallel::set_max_threads(4); }
+  ~RebinLargeTest() { parallel::set_max_threads(0); }
+
+  static constexpr scipp::index ny = 2000;
+  static constexpr scipp::index nx = 300;
+
+  static Variable make_edges(const Dim dim, const scipp::index size,
+                             const double step) {
+    std::vector<double> edges(size);
+    for (scipp::index i = 0; i < size; ++i)
+      edges[i] = i * step;
+    return makeVariable<double>(Dims{dim}, Shape{size}, Values(edges));
+  }
+
+  Variable counts = [] {
+    auto var = makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{ny, nx},
+                                    units::Unit(units::counts));
+    auto values = var.values<double>();
+    for (scipp::index i = 0; i < ny * nx; ++i)
+      values[i] = i % 17;
+    return var;
+  }();
+};
+
+TEST_F(RebinLargeTest, inner) {
+  const auto x = make_edges(Dim::X, nx + 1, 1.0);
+  const auto edges = make_edges(Dim::X, nx / 2 + 1, 2.0);
+  const auto result = rebin(counts, Dim::X, x, edges);
+  const auto values = counts.values<double>();
+  for (scipp::index y = 0; y < ny; ++y)
+    for (scipp::index i = 0; i < nx / 2; ++i)
+      ASSERT_EQ(result.values<double>()[y * nx / 2 + i],
+                values[y * nx + 2 * i] + values[y * nx + 2 * i + 1]);
+}
+
+TEST_F(RebinLargeTest, outer) {
+  const auto y = make_edges(Dim::Y, ny + 1, 1.0);
+  const auto edges = make_edges(Dim::Y, ny / 2 + 1, 2.0);
+  const auto result = rebin(counts, Dim::Y, y, edges);
+  const auto values = counts.values<double>();
+  for (scipp::index i = 0; i < ny / 2; ++i)
+    for (scipp::index x = 0; x < nx; ++x)
+      ASSERT_EQ(result.values<double>()[i * nx + x],
+                values[2 * i * nx + x] + values[(2 * i + 1) * nx + x]);
+}
+
+TEST_F(RebinLargeTest, outer_unaligned_edges) {
+  const auto y = make_edges(Dim::Y, ny + 1, 1.0);
+  const auto edges = make_edges(Dim::Y, ny, 1.0) + 0.5;
+  const auto result = rebin(counts, Dim::Y, y, edges);
+  const auto values = counts.values<double>();
+  for (scipp::index i = 0; i < ny - 1; ++i)
+    for (scipp::index x = 0; x < nx; ++x)
+      ASSERT_EQ(result.values<double>()[i * nx + x],
+                0.5 * values[i * nx + x] + 0.5 * values[(i + 1) * nx + x]);
+}
+
+TEST_F(RebinLargeTest, outer_of_slice) {
+  const auto y = make_edges(Dim::Y, ny + 1, 1.0);
+  const auto edges = make_edges(Dim::Y, ny / 2 + 1, 2.0);
+  const auto slice = counts.slice({Dim::X, 10, 20});
+  EXPECT_EQ(rebin(slice, Dim::Y, y, edges),
+            rebin(counts, Dim::Y, y, edges).slice({Dim::X, 10, 20}));
+}
+
+TEST(RebinMaskOuterTest, mask_outer) {
+  const auto y = makeVariable<double>(Dims{Dim::Y}, Shape{5},
+                                      Values{1.0, 2.0, 3.0, 4.0, 5.0});
+  const auto mask = makeVariable<bool>(
+      Dims{Dim::Y, Dim::X}, Shape{4, 2},
+      Values{false, false, true, false, false, false, false, true});
+  const auto edges =
+      makeVariable<double>(Dims{Dim::Y}, Shape{3}, Values{1.0, 2.5, 5.0});
+  const auto expected = makeVariable<bool>(Dims{Dim::Y, Dim::X}, Shape{2, 2},
+                                           Values{true, false, true, true});
+  EXPECT_EQ(rebin(mask, Dim::Y, y, edges), expected);
+}
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include "scipp/core/dataset.h"
+#include "scipp/core/parallel.h"
 #include "scipp/core/variable.h"
 
 using namespace scipp;
@@ -53,3 +54,69 @@ TEST(ReduceSparseTest, flatten_dataset_with_mask) {
   EXPECT_EQ(flat["b"].labels()["label"], expected);
   EXPECT_EQ(flat["b"].data(), expected);
 }
+
+struct ReduceSparseLargeTest : public ::testing::Test {
+  // Use multiple threads also on machines with few cores.
+  ReduceSparseLargeTest() { parallel::set_max_threads(4); }
+  ~ReduceSparseLargeTest() { parallel::set_max_threads(0); }
+
+  static constexpr scipp::index nz = 3;
+  static constexpr scipp::index ny = 10000;
+
+  static sparse_container<double> events(const scipp::index z,
+                                         const scipp::index y) {
+    sparse_container<double> out;
+    for (scipp::index i = 0; i < (y + z) % 5; ++i)
+      out.push_back(1000.0 * y + 10.0 * z + i);
+    return out;
+  }
+
+  Variable var = [] {
+    auto var = makeVariable<double>(Dims{Dim::Z, Dim::Y, Dim::X},
+                                    Shape{nz, ny, Dimensions::Sparse},
+                                    Values{}, Variances{});
+    for (scipp::index z = 0; z < nz; ++z)
+      for (scipp::index y = 0; y < ny; ++y) {
+        var.sparseValues<double>()[z * ny + y] = events(z, y);
+        var.sparseVariances<double>()[z * ny + y] = events(z, y);
+      }
+    return var;
+  }();
+};
+
+TEST_F(ReduceSparseLargeTest, flatten_inner) {
+  auto expected = makeVariable<double>(Dims{Dim::Z, Dim::X},
+                                       Shape{nz, Dimensions::Sparse},
+                                       Values{}, Variances{});
+  for (scipp::index z = 0; z < nz; ++z)
+    for (scipp::index y = 0; y < ny; ++y) {
+      const auto e = events(z, y);
+      auto &values = expected.sparseValues<double>()[z];
+      auto &variances = expected.sparseVariances<double>()[z];
+      values.insert(values.end(), e.begin(), e.end());
+      variances.insert(variances.end(), e.begin(), e.end());
+    }
+  EXPECT_EQ(flatten(var, Dim::Y), expected);
+}
+
+TEST_F(ReduceSparseLargeTest, flatten_outer_with_mask) {
+  std::vector<bool> masked(nz);
+  masked[1] = true;
+  DataArray a(var, {}, {}, {{"z", makeVariable<bool>(Dims{Dim::Z}, Shape{nz},
+                                                     Values{false, true,
+                                                            false})}});
+  auto expected = makeVariable<double>(Dims{Dim::Y, Dim::X},
+                                       Shape{ny, Dimensions::Sparse},
+                                       Values{}, Variances{});
+  for (scipp::index y = 0; y < ny; ++y)
+    for (scipp::index z = 0; z < nz; ++z) {
+      if (masked[z])
+        continue;
+      const auto e = events(z, y);
+      auto &values = expected.sparseValues<double>()[y];
+      auto &variances = expected.sparseVariances<double>()[y];
+      values.insert(values.end(), e.begin(), e.end());
+      variances.insert(variances.end(), e.begin(), e.end());
+    }
+  EXPECT_EQ(flatten(a, Dim::Z).data(), expected);
+}
@@ -1,7 +1,9 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
 #include <gtest/gtest.h>
+#include <numeric>
 
+#include "scipp/core/parallel.h"
 #include "scipp/core/variable.h"
 
 using namespace scipp;
@@ -43,3 +45,41 @@ TEST(ReduceTest, min_max_with_variances) {
             makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{1, 3},
                                  Variances{5, 7}));
 }
+
+class ReduceChunkedTest : public ::testing::Test {
+protected:
+  // Enforce use of partial results also when running on a single thread.
+  ReduceChunkedTest() { parallel::set_deterministic_reductions(true); }
+  ~ReduceChunkedTest() override {
+    parallel::set_deterministic_reductions(false);
+  }
+
+  // Large enough to be split into several chunks.
+  static constexpr scipp::index ny = 40000;
+};
+
+TEST_F(ReduceChunkedTest, min_max) {
+  auto var = makeVariable<double>(Dimensions{{Dim::Y, ny}, {Dim::X, 2}});
+  auto vals = var.values<double>();
+  std::iota(vals.begin(), vals.end(), -ny);
+  EXPECT_EQ(max(var, Dim::Y), makeVariable<double>(Dims{Dim::X}, Shape{2},
+                                                   Values{ny - 2, ny - 1}));
+  EXPECT_EQ(min(var, Dim::Y), makeVariable<double>(Dims{Dim::X}, Shape{2},
+                                                   Values{-ny, -ny + 1}));
+}
+
+TEST_F(ReduceChunkedTest, any_all) {
+  auto var = makeVariable<bool>(Dimensions{{Dim::Y, ny}, {Dim::X, 2}});
+  auto vals = var.values<bool>();
+  std::fill(vals.begin(), vals.end(), true);
+  vals[2 * ny - 2] = false;
+  vals[2 * ny - 1] = false;
+  EXPECT_EQ(any(var, Dim::Y), makeVariable<bool>(Dims{Dim::X}, Shape{2},
+                                                 Values{true, true}));
+  EXPECT_EQ(all(var, Dim::Y), makeVariable<bool>(Dims{Dim::X}, Shape{2},
+                                                 Values{false, false}));
+  std::fill(vals.begin(), vals.end(), false);
+  vals[ny + 1] = true;
+  EXPECT_EQ(any(var, Dim::Y), makeVariable<bool>(Dims{Dim::X}, Shape{2},
+                                                 Values{false, true}));
+}
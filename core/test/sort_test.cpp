@@ -1,8 +1,14 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+#include "random.h"
 #include "test_macros.h"
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "scipp/core/parallel.h"
 #include "scipp/core/sort.h"
 
 using namespace scipp;
@@ -73,3 +79,94 @@ TEST(SortTest, dataset_1d) {
   // - Should we preserve scalars?
   EXPECT_EQ(sort(d, key), expected);
 }
+
+class SortLargeTest : public ::testing::Test {
+protected:
+  // Use multiple threads also on machines with few cores.
+  SortLargeTest() { parallel::set_max_threads(4); }
+  ~SortLargeTest() override { parallel::set_max_threads(0); }
+
+  // Large enough to use the radix or merge sort on several threads.
+  static constexpr scipp::index size = 300000;
+
+  // Check that `sort` matches std::stable_sort, using the position of every
+  // element as data to verify stability.
+  template <class T> void expect_stable_sorted(const std::vector<T> &keys) {
+    std::vector<int64_t> position(keys.size());
+    std::iota(position.begin(), position.end(), 0);
+    auto expected(position);
+    std::stable_sort(expected.begin(), expected.end(),
+                     [&](const auto i, const auto j) {
+                       return keys[i] < keys[j];
+                     });
+    const auto n = scipp::size(keys);
+    const auto var = makeVariable<int64_t>(
+        Dims{Dim::X}, Shape{n}, Values(position.begin(), position.end()));
+    const auto key = makeVariable<T>(Dims{Dim::X}, Shape{n},
+                                     Values(keys.begin(), keys.end()));
+    EXPECT_EQ(sort(var, key),
+              makeVariable<int64_t>(Dims{Dim::X}, Shape{n},
+                                    Values(expected.begin(), expected.end())));
+  }
+
+  template <class T> std::vector<T> make_keys(const double min,
+                                              const double max) {
+    Random rand(min, max);
+    rand.seed(78);
+    const auto values = rand(size);
+    return std::vector<T>(values.begin(), values.end());
+  }
+};
+
+TEST_F(SortLargeTest, double_key) {
+  auto keys = make_keys<double>(-1e3, 1e3);
+  keys[7] = -0.0;
+  keys[8] = 0.0;
+  keys[9] = std::numeric_limits<double>::infinity();
+  keys[10] = -std::numeric_limits<double>::infinity();
+  keys[11] = std::numeric_limits<double>::lowest();
+  keys[12] = std::numeric_limits<double>::max();
+  keys[13] = std::numeric_limits<double>::denorm_min();
+  // Duplicates for testing stability.
+  std::copy(keys.begin(), keys.begin() + 1000, keys.end() - 1000);
+  expect_stable_sorted(keys);
+}
+
+TEST_F(SortLargeTest, float_key) {
+  auto keys = make_keys<float>(-1e3, 1e3);
+  keys[7] = -std::numeric_limits<float>::infinity();
+  keys[8] = std::numeric_limits<float>::lowest();
+  std::copy(keys.begin(), keys.begin() + 1000, keys.end() - 1000);
+  expect_stable_sorted(keys);
+}
+
+TEST_F(SortLargeTest, int64_key) {
+  auto keys = make_keys<int64_t>(-1e12, 1e12);
+  keys[7] = std::numeric_limits<int64_t>::min();
+  keys[8] = std::numeric_limits<int64_t>::max();
+  expect_stable_sorted(keys);
+  // Few distinct values, many duplicates.
+  expect_stable_sorted(make_keys<int64_t>(-3, 3));
+}
+
+TEST_F(SortLargeTest, int32_key) {
+  auto keys = make_keys<int32_t>(-1e9, 1e9);
+  keys[7] = std::numeric_limits<int32_t>::min();
+  keys[8] = std::numeric_limits<int32_t>::max();
+  expect_stable_sorted(keys);
+  expect_stable_sorted(make_keys<int32_t>(0, 1000));
+}
+
+TEST_F(SortLargeTest, bool_key) {
+  RandomBool rand;
+  rand.seed(78);
+  expect_stable_sorted(rand(size));
+}
+
+TEST_F(SortLargeTest, string_key) {
+  const auto values = make_keys<int64_t>(0, 1e4);
+  std::vector<std::string> keys;
+  for (const auto &value : values)
+    keys.emplace_back(std::to_string(value));
+  expect_stable_sorted(keys);
+}
@@ -1,9 +1,11 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
 #include <gtest/gtest.h>
+#include <numeric>
 #include <vector>
 
 #include "scipp/core/dataset.h"
+#include "scipp/core/parallel.h"
 
 using namespace scipp;
 using namespace scipp::core;
@@ -79,3 +81,68 @@ TEST_F(Sum2dCoordTest, data_array_bad_2d_labels_fail) {
   // Values being summed have different x labels -> fail.
   EXPECT_THROW(sum(a, Dim::Y), except::CoordMismatchError);
 }
+
+class SumChunkedTest : public ::testing::Test {
+protected:
+  // Enforce use of partial results also when running on a single thread.
+  SumChunkedTest() { parallel::set_deterministic_reductions(true); }
+  ~SumChunkedTest() override { parallel::set_deterministic_reductions(false); }
+
+  // Large enough to be split into several chunks.
+  static constexpr scipp::index ny = 40000;
+  Variable make_var() {
+    auto var = makeVariable<double>(Dimensions{{Dim::Y, ny}, {Dim::X, 2}},
+                                    Values{}, Variances{});
+    auto vals = var.values<double>();
+    std::iota(vals.begin(), vals.end(), 0.0);
+    auto vars = var.variances<double>();
+    std::fill(vars.begin(), vars.end(), 1.0);
+    return var;
+  }
+};
+
+TEST_F(SumChunkedTest, outer_dim) {
+  const double n = ny * (ny - 1);
+  EXPECT_EQ(sum(make_var(), Dim::Y),
+            makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{n, n + ny},
+                                 Variances{ny, ny}));
+}
+
+TEST_F(SumChunkedTest, inner_dim) {
+  const auto summed = sum(make_var(), Dim::X);
+  const auto vals = summed.values<double>();
+  const auto vars = summed.variances<double>();
+  for (scipp::index i = 0; i < ny; ++i) {
+    ASSERT_EQ(vals[i], 4.0 * i + 1.0);
+    ASSERT_EQ(vars[i], 2.0);
+  }
+}
+
+TEST_F(SumChunkedTest, accumulates_into_existing_output) {
+  auto out = makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{1.0, 2.0},
+                                  Variances{3.0, 4.0});
+  sum(make_var(), Dim::Y, out);
+  // In-place sum does not reset the output.
+  const double n = ny * (ny - 1);
+  EXPECT_EQ(out, makeVariable<double>(Dims{Dim::X}, Shape{2},
+                                      Values{n + 1.0, n + ny + 2.0},
+                                      Variances{ny + 3.0, ny + 4.0}));
+}
+
+TEST_F(SumChunkedTest, bool) {
+  auto var = makeVariable<bool>(Dimensions{{Dim::Y, ny}, {Dim::X, 2}});
+  auto vals = var.values<bool>();
+  for (scipp::index i = 0; i < ny; ++i)
+    vals[2 * i] = i % 3 == 0;
+  EXPECT_EQ(sum(var, Dim::Y),
+            makeVariable<int64_t>(Dims{Dim::X}, Shape{2},
+                                  Values{(ny + 2) / 3, int64_t{0}}));
+}
+
+TEST_F(SumChunkedTest, vector_3d) {
+  auto var = makeVariable<Eigen::Vector3d>(Dimensions{Dim::Y, ny});
+  auto vals = var.values<Eigen::Vector3d>();
+  std::fill(vals.begin(), vals.end(), Eigen::Vector3d(1, 2, 3));
+  EXPECT_EQ(sum(var, Dim::Y), makeVariable<Eigen::Vector3d>(Values{
+                                  Eigen::Vector3d(ny, 2 * ny, 3 * ny)}));
+}
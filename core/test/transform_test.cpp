@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
 #include <gtest/gtest.h>
+#include <numeric>
 #include <vector>
 
 #include "test_macros.h"
@@ -907,3 +908,66 @@ TEST_F(TransformInPlaceDryRunTest, unchanged_if_success) {
   dry_run::transform_in_place<pair_self_t<double>>(a, a, binary);
   EXPECT_EQ(a, original);
 }
+
+class TransformParallelTest : public ::testing::Test {
+protected:
+  // Use multiple threads also on machines with few cores.
+  TransformParallelTest() { parallel::set_max_threads(4); }
+  ~TransformParallelTest() override { parallel::set_max_threads(0); }
+
+  // Large enough to be split into several chunks by transform.
+  static constexpr scipp::index size = 5 * parallel::default_grainsize + 3;
+  Variable make_var() {
+    auto var = makeVariable<double>(Dimensions{{Dim::Y, size}, {Dim::X, 2}});
+    auto vals = var.values<double>();
+    std::iota(vals.begin(), vals.end(), 0.0);
+    return var;
+  }
+};
+
+TEST_F(TransformParallelTest, transform) {
+  const auto var = make_var();
+  const auto result = transform<double>(
+      var, overloaded{[](const auto x) { return 2.0 * x; },
+                      [](const units::Unit &unit) { return unit; }});
+  const auto vals = result.values<double>();
+  for (scipp::index i = 0; i < 2 * size; ++i)
+    ASSERT_EQ(vals[i], 2.0 * i);
+}
+
+TEST_F(TransformParallelTest, transform_in_place_broadcast_input) {
+  auto var = make_var();
+  auto y = makeVariable<double>(Dimensions{Dim::Y, size});
+  auto yvals = y.values<double>();
+  std::iota(yvals.begin(), yvals.end(), 0.0);
+  transform_in_place<pair_self_t<double>>(
+      var, y,
+      overloaded{[](auto &a, const auto &b) { a += b; },
+                 [](units::Unit &, const units::Unit &) {}});
+  const auto vals = var.values<double>();
+  for (scipp::index i = 0; i < size; ++i) {
+    ASSERT_EQ(vals[2 * i], 3.0 * i);
+    ASSERT_EQ(vals[2 * i + 1], 3.0 * i + 1.0);
+  }
+}
+
+TEST_F(TransformParallelTest, transform_in_place_slice) {
+  auto var = make_var();
+  transform_in_place<double>(var.slice({Dim::X, 1}),
+                             overloaded{[](auto &x) { x = -x; },
+                                        [](units::Unit &) {}});
+  const auto vals = var.values<double>();
+  for (scipp::index i = 0; i < size; ++i) {
+    ASSERT_EQ(vals[2 * i], 2.0 * i);
+    ASSERT_EQ(vals[2 * i + 1], -2.0 * i - 1.0);
+  }
+}
+
+TEST_F(TransformParallelTest, accumulate_with_broadcast_output) {
+  const auto var = make_var();
+  auto sum = makeVariable<double>(Dims{Dim::X}, Shape{2});
+  accumulate_in_place<pair_self_t<double>>(
+      sum, var, [](auto &a, const auto &b) { a += b; });
+  const double n = size;
+  EXPECT_TRUE(equals(sum.values<double>(), {n * (n - 1), n * n}));
+}
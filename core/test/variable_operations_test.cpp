@@ -551,6 +551,65 @@ TEST(SparseVariable, concatenate_along_sparse_dimension_with_variances) {
   EXPECT_TRUE(equals(vars[1], {4, 5}));
 }
 
+TEST(SparseVariable, concatenate_along_sparse_dimension_float_with_variances) {
+  auto a = makeVariable<float>(Dims{Dim::Y, Dim::X},
+                               Shape{2, Dimensions::Sparse},
+                               units::Unit(units::us), Values{}, Variances{});
+  a.sparseValues<float>()[0] = {1, 2};
+  a.sparseVariances<float>()[0] = {3, 4};
+  auto b = makeVariable<float>(Dims{Dim::Y, Dim::X},
+                               Shape{2, Dimensions::Sparse},
+                               units::Unit(units::us), Values{}, Variances{});
+  b.sparseValues<float>()[1] = {5};
+  b.sparseVariances<float>()[1] = {6};
+
+  auto var = concatenate(a, b, Dim::X);
+  EXPECT_EQ(var.dtype(), dtype<float>);
+  EXPECT_EQ(var.unit(), units::us);
+  EXPECT_TRUE(equals(var.sparseValues<float>()[0], {1, 2}));
+  EXPECT_TRUE(equals(var.sparseValues<float>()[1], {5}));
+  EXPECT_TRUE(equals(var.sparseVariances<float>()[0], {3, 4}));
+  EXPECT_TRUE(equals(var.sparseVariances<float>()[1], {6}));
+}
+
+TEST(SparseVariable, concatenate_along_sparse_dimension_int) {
+  auto a = makeVariable<int64_t>(Dims{Dim::Y, Dim::X},
+                                 Shape{2, Dimensions::Sparse});
+  a.sparseValues<int64_t>()[0] = {1, 2};
+  auto var = concatenate(a, a, Dim::X);
+  EXPECT_TRUE(equals(var.sparseValues<int64_t>()[0], {1, 2, 1, 2}));
+  EXPECT_TRUE(var.sparseValues<int64_t>()[1].empty());
+
+  auto b = makeVariable<int32_t>(Dims{Dim::X}, Shape{Dimensions::Sparse});
+  b.sparseValues<int32_t>()[0] = {3};
+  EXPECT_TRUE(
+      equals(concatenate(b, b, Dim::X).sparseValues<int32_t>()[0], {3, 3}));
+}
+
+TEST(SparseVariable, concatenate_along_sparse_dimension_slices) {
+  auto a = makeVariable<double>(Dims{Dim::Y, Dim::X},
+                                Shape{3, Dimensions::Sparse});
+  a.sparseValues<double>()[0] = {1};
+  a.sparseValues<double>()[1] = {2};
+  a.sparseValues<double>()[2] = {3};
+  auto var = concatenate(a.slice({Dim::Y, 0, 2}), a.slice({Dim::Y, 1, 3}),
+                         Dim::X);
+  EXPECT_TRUE(equals(var.sparseValues<double>()[0], {1, 2}));
+  EXPECT_TRUE(equals(var.sparseValues<double>()[1], {2, 3}));
+}
+
+TEST(SparseVariable, concatenate_along_sparse_dimension_fail) {
+  auto a = makeVariable<double>(Dims{Dim::Y, Dim::X},
+                                Shape{2, Dimensions::Sparse});
+  auto b = makeVariable<double>(Dims{Dim::Y, Dim::X},
+                                Shape{3, Dimensions::Sparse});
+  EXPECT_THROW(concatenate(a, b, Dim::X), except::DimensionMismatchError);
+  auto c = makeVariable<double>(Dims{Dim::Y, Dim::X},
+                                Shape{2, Dimensions::Sparse}, Values{},
+                                Variances{});
+  EXPECT_THROW(concatenate(a, c, Dim::X), except::VariancesError);
+}
+
 #ifdef SCIPP_UNITS_NEUTRON
 TEST(Variable, rebin) {
   auto var = makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{1.0, 2.0});
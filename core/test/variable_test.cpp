@@ -297,6 +297,54 @@ TEST(VariableTest, copy_and_move) {
   EXPECT_EQ(moved, reference);
 }
 
+TEST(VariableTest, copy_shares_data_until_write) {
+  auto var = makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{1.1, 2.2},
+                                  Variances{0.1, 0.2});
+  auto copy(var);
+  const auto &const_var = var;
+  const auto &const_copy = copy;
+  EXPECT_EQ(const_copy.values<double>().data(),
+            const_var.values<double>().data());
+
+  copy.values<double>()[0] = 3.3;
+  EXPECT_NE(const_copy.values<double>().data(),
+            const_var.values<double>().data());
+  EXPECT_EQ(var, makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{1.1, 2.2},
+                                      Variances{0.1, 0.2}));
+  EXPECT_EQ(copy, makeVariable<double>(Dims{Dim::X}, Shape{2},
+                                       Values{3.3, 2.2}, Variances{0.1, 0.2}));
+}
+
+TEST(VariableTest, copy_unaffected_by_write_to_original) {
+  auto var = makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{1.1, 2.2});
+  const auto copy(var);
+  var.slice({Dim::X, 1}) += makeVariable<double>(Values{1.0});
+  var.rename(Dim::X, Dim::Y);
+  EXPECT_EQ(copy,
+            makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{1.1, 2.2}));
+  EXPECT_EQ(var,
+            makeVariable<double>(Dims{Dim::Y}, Shape{2}, Values{1.1, 3.2}));
+}
+
+TEST(VariableTest, copy_after_creating_span_does_not_share) {
+  auto var = makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{1.1, 2.2});
+  auto values = var.values<double>();
+  const auto copy(var);
+  values[0] = 3.3;
+  EXPECT_EQ(copy,
+            makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{1.1, 2.2}));
+}
+
+TEST(VariableTest, copy_assign_does_not_write_to_shared) {
+  auto var = makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{1.1, 2.2});
+  const auto copy(var);
+  var = makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{3.3, 4.4});
+  EXPECT_EQ(copy,
+            makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{1.1, 2.2}));
+  EXPECT_EQ(var,
+            makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{3.3, 4.4}));
+}
+
 TEST(Variable, assign_slice) {
   const auto parent = makeVariable<double>(
       Dims{Dim::X, Dim::Y, Dim::Z}, Shape{4, 2, 3},
@@ -39,6 +39,20 @@ VariableConcept *VariableConceptHandle_impl<Known...>::operator->() const {
       m_object);
 }
 
+/// Return true if the concept is not shared with any other handle.
+template <class... Known>
+bool VariableConceptHandle_impl<Known...>::unique() const noexcept {
+  return std::visit([](auto &&ptr) { return ptr.use_count() <= 1; },
+                    m_object);
+}
+
+/// Copy the concept if it is shared with other handles, such that it can be
+/// modified without affecting the other handles.
+template <class... Known> void VariableConceptHandle_impl<Known...>::detach() {
+  if (*this && !unique() && !(*this)->isView())
+    *this = (*this)->clone();
+}
+
 template <class... Known>
 typename VariableConceptHandle_impl<Known...>::variant_t
 VariableConceptHandle_impl<Known...>::variant() const noexcept {
@@ -59,6 +73,9 @@ template SCIPP_CORE_EXPORT VariableConcept &VariableConceptHandle_impl<KNOWN>::
 operator*() const;
 template SCIPP_CORE_EXPORT VariableConcept *VariableConceptHandle_impl<KNOWN>::
 operator->() const;
+template SCIPP_CORE_EXPORT bool
+VariableConceptHandle_impl<KNOWN>::unique() const noexcept;
+template SCIPP_CORE_EXPORT void VariableConceptHandle_impl<KNOWN>::detach();
 template SCIPP_CORE_EXPORT typename VariableConceptHandle_impl<KNOWN>::variant_t
 VariableConceptHandle_impl<KNOWN>::variant() const noexcept;
 
@@ -70,7 +87,7 @@ Variable::Variable(const VariableConstProxy &slice)
   // There is a bug in the implementation of MultiIndex used in VariableView
   // in case one of the dimensions has extent 0.
   if (dims().volume() != 0)
-    data().copy(slice.data(), Dim::Invalid, 0, 0, 1);
+    m_object->copy(slice.data(), Dim::Invalid, 0, 0, 1);
 }
 
 Variable::Variable(const Variable &parent, const Dimensions &dims)
@@ -86,8 +103,10 @@ Variable::Variable(const Variable &parent, VariableConceptHandle data)
 
 void Variable::setDims(const Dimensions &dimensions) {
   if (dimensions.volume() == m_object->dims().volume()) {
-    if (dimensions != m_object->dims())
-      data().m_dimensions = dimensions;
+    if (dimensions != m_object->dims()) {
+      m_object.detach();
+      m_object->m_dimensions = dimensions;
+    }
     return;
   }
   m_object = m_object->makeDefaultFromParent(dimensions);
@@ -218,8 +237,10 @@ VariableProxy VariableProxy::transpose(const std::vector<Dim> &dims) const {
 }
 
 void Variable::rename(const Dim from, const Dim to) {
-  if (dims().contains(from))
-    data().m_dimensions.relabel(dims().index(from), to);
+  if (dims().contains(from)) {
+    m_object.detach();
+    m_object->m_dimensions.relabel(dims().index(from), to);
+  }
 }
 
 } // namespace scipp::core
@@ -8,6 +8,8 @@
 #include "scipp/core/counts.h"
 #include "scipp/core/dtype.h"
 #include "scipp/core/except.h"
+#include "scipp/core/parallel.h"
+#include "scipp/core/tag_util.h"
 #include "scipp/core/transform.h"
 #include "scipp/core/variable.h"
 
@@ -30,6 +32,44 @@ std::vector<Variable> split(const Variable &var, const Dim dim,
   return vars;
 }
 
+namespace concatenate_detail {
+/// Append the events of `b` to those of `a`, for each element of `out`.
+template <class Out, class A, class B>
+void concatenate_events(const Out &out, const A &a, const B &b) {
+  parallel::parallel_for(
+      parallel::blocked_range(0, out.size()), [&](const auto &range) {
+        for (auto i = range.begin(); i < range.end(); ++i) {
+          auto &events = out[i];
+          const auto &events_a = a[i];
+          const auto &events_b = b[i];
+          events.reserve(events_a.size() + events_b.size());
+          events.insert(events.end(), events_a.begin(), events_a.end());
+          events.insert(events.end(), events_b.begin(), events_b.end());
+        }
+      });
+}
+
+template <class T> struct ConcatenateSparse {
+  static Variable apply(const VariableConstProxy &a,
+                        const VariableConstProxy &b) {
+    // Fresh event lists, so each is allocated once with its final size.
+    auto out = a.hasVariances()
+                   ? makeVariable<T>(Dimensions{a.dims()}, units::Unit(a.unit()),
+                                     Values{}, Variances{})
+                   : makeVariable<T>(Dimensions{a.dims()},
+                                     units::Unit(a.unit()));
+    concatenate_events(out.template sparseValues<T>(),
+                       a.template sparseValues<T>(),
+                       b.template sparseValues<T>());
+    if (a.hasVariances())
+      concatenate_events(out.template sparseVariances<T>(),
+                         a.template sparseVariances<T>(),
+                         b.template sparseVariances<T>());
+    return out;
+  }
+};
+} // namespace concatenate_detail
+
 Variable concatenate(const VariableConstProxy &a1, const VariableConstProxy &a2,
                      const Dim dim) {
   if (a1.dtype() != a2.dtype())
@@ -40,16 +80,12 @@ Variable concatenate(const VariableConstProxy &a1, const VariableConstProxy &a2,
         "Cannot concatenate Variables: Units do not match.");
 
   if (a1.dims().sparseDim() == dim && a2.dims().sparseDim() == dim) {
-    Variable out(a1);
-    transform_in_place<pair_self_t<sparse_container<double>>>(
-        out, a2,
-        overloaded{[](auto &a, const auto &b) {
-                     a.insert(a.end(), b.begin(), b.end());
-                   },
-                   [](units::Unit &a, const units::Unit &b) {
-                     expect::equals(a, b);
-                   }});
-    return out;
+    expect::equals(a1.dims(), a2.dims());
+    if (a1.hasVariances() != a2.hasVariances())
+      throw except::VariancesError("Cannot concatenate Variables: Either both "
+                                   "or neither must have variances.");
+    return CallDType<double, float, int64_t, int32_t>::apply<
+        concatenate_detail::ConcatenateSparse>(a1.dtype(), a1, a2);
   }
 
   const auto &dims1 = a1.dims();
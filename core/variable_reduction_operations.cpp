@@ -2,17 +2,109 @@
 // Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
 /// @file
 /// @author Simon Heybrock
+#include <algorithm>
+#include <vector>
+
 #include "scipp/core/dataset.h"
 #include "scipp/core/dtype.h"
 #include "scipp/core/except.h"
+#include "scipp/core/parallel.h"
 #include "scipp/core/transform.h"
 #include "scipp/core/variable.h"
+#include "scipp/core/view_index.h"
 
 #include "operators.h"
 #include "variable_operations_common.h"
 
 namespace scipp::core {
 
+namespace reduce_detail {
+/// Upper limit for the number of partial results of a reduction if
+/// parallel::deterministic_reductions() is enabled.
+static constexpr scipp::index max_partials = 64;
+
+/// Return zero-initialized variable with given dimensions and same dtype and
+/// unit as `parent`, with variances if `parent` has variances.
+Variable make_zeros(const VariableConstProxy &parent, const Dimensions &dims) {
+  Variable zeros(parent, dims);
+  // Elements of Eigen types are not initialized by their default constructor.
+  if (zeros.dtype() == dtype<Eigen::Vector3d>) {
+    auto values = zeros.values<Eigen::Vector3d>();
+    std::fill(values.begin(), values.end(), Eigen::Vector3d::Zero());
+  }
+  return zeros;
+}
+
+/// Reduce `var` into `out` by calling `accumulate(out, var)` for chunks of
+/// `var`, in parallel.
+///
+/// The input is split along its outer dimension. If `out` depends on this
+/// dimension the output slices for different chunks are disjoint. Otherwise
+/// each chunk is accumulated into a private partial result obtained from
+/// `make_partial(out)`, and the partial results are combined pairwise in a
+/// tree. Chunk boundaries and the order of combination depend only on the
+/// number of chunks, see also parallel::set_deterministic_reductions.
+template <class Accumulate, class MakePartial>
+void reduce_chunked(const VariableProxy &out, const VariableConstProxy &var,
+                    Accumulate accumulate, MakePartial make_partial) {
+  const auto &dims = var.dims();
+  if (dims.ndim() == 0 || dims.sparse() || dims.volume() == 0)
+    return accumulate(out, var);
+  const Dim dim = dims.labels()[0];
+  const auto extent = dims[dim];
+  const auto slice_volume = dims.volume() / extent;
+  const auto chunk = [&](const scipp::index begin, const scipp::index end) {
+    return var.slice({dim, begin, end});
+  };
+
+  if (out.dims().contains(dim)) {
+    const auto grainsize =
+        std::max(scipp::index{1}, parallel::grainsize() / slice_volume);
+    parallel::parallel_for(parallel::blocked_range(0, extent, grainsize),
+                           [&](const auto &range) {
+                             accumulate(out.slice({dim, range.begin(),
+                                                   range.end()}),
+                                        chunk(range.begin(), range.end()));
+                           });
+    return;
+  }
+
+  // Chunks contain at least as many elements as `out` to bound the memory used
+  // for partial results as well as the cost of combining them.
+  const auto grainsize = std::max(
+      scipp::index{1},
+      std::max(parallel::grainsize(), out.dims().volume()) /
+          slice_volume);
+  const parallel::blocked_range range(0, extent, grainsize);
+  const auto n = parallel::deterministic_reductions()
+                     ? std::clamp(extent / grainsize, scipp::index{1},
+                                  max_partials)
+                     : parallel::detail::chunk_count(range);
+  if (n <= 1)
+    return accumulate(out, var);
+
+  std::vector<Variable> partials;
+  for (scipp::index i = 1; i < n; ++i)
+    partials.emplace_back(make_partial(out));
+  const auto partial = [&](const scipp::index i) {
+    return i == 0 ? out : VariableProxy(partials[i - 1]);
+  };
+  parallel::parallel_for(parallel::blocked_range(0, n), [&](const auto &r) {
+    for (auto i = r.begin(); i < r.end(); ++i)
+      accumulate(partial(i), chunk(extent * i / n, extent * (i + 1) / n));
+  });
+  for (scipp::index stride = 1; stride < n; stride *= 2) {
+    const auto pairs = (n - 1 + stride) / (2 * stride);
+    parallel::parallel_for(
+        parallel::blocked_range(0, pairs), [&](const auto &r) {
+          for (auto i = r.begin(); i < r.end(); ++i)
+            accumulate(partial(2 * stride * i),
+                       partial(2 * stride * i + stride));
+        });
+  }
+}
+} // namespace reduce_detail
+
 namespace sparse {
 /// Return array of sparse dimension extents, i.e., total counts.
 Variable counts(const VariableConstProxy &var) {
@@ -51,9 +143,68 @@ void reserve(const VariableProxy &sparse, const VariableConstProxy &capacity) {
 } // namespace sparse
 
 namespace flatten_detail {
+/// Return pointers to all elements of `view`, in iteration order.
+template <class View> auto pointers(View &&view) {
+  std::vector<decltype(&*view.begin())> out;
+  out.reserve(view.size());
+  for (auto &item : view)
+    out.push_back(&item);
+  return out;
+}
+
+/// Concatenate the sparse containers of `var` that are not masked into the
+/// containers of `summed` that they are mapped to by broadcasting.
+///
+/// The position of each input container in its output is computed upfront as
+/// a prefix sum over the sizes of the preceding inputs mapping to the same
+/// output. Outputs are then resized once and inputs are copied to their final
+/// position in parallel.
 template <class T>
-using args = std::tuple<sparse_container<T>, sparse_container<T>, bool>;
+void flatten(const VariableProxy &summed, const VariableConstProxy &var,
+             const Variable &mask) {
+  using Events = sparse_container<T>;
+  const auto inDims = denseDims(var.dims());
+  const auto in = pointers(var.values<Events>());
+  const auto out = pointers(summed.values<Events>());
+  const auto masked = mask.values<bool>();
+
+  std::vector<scipp::index> target(in.size());
+  std::vector<scipp::index> offset(in.size(), -1);
+  std::vector<scipp::index> size(out.size());
+  for (scipp::index i = 0; i < scipp::size(out); ++i)
+    size[i] = scipp::size(*out[i]);
+  ViewIndex outIndex(inDims, denseDims(summed.dims()));
+  ViewIndex maskIndex(inDims, mask.dims());
+  for (scipp::index i = 0; i < scipp::size(in); ++i) {
+    target[i] = outIndex.get();
+    if (!masked[maskIndex.get()]) {
+      offset[i] = size[target[i]];
+      size[target[i]] += scipp::size(*in[i]);
+    }
+    outIndex.increment();
+    maskIndex.increment();
+  }
+
+  const auto concatenate = [&](const auto &in_, const auto &out_) {
+    parallel::parallel_for(
+        parallel::blocked_range(0, scipp::size(out_)), [&](const auto &r) {
+          for (auto i = r.begin(); i < r.end(); ++i)
+            out_[i]->resize(size[i], boost::container::default_init);
+        });
+    parallel::parallel_for(
+        parallel::blocked_range(0, scipp::size(in_)), [&](const auto &r) {
+          for (auto i = r.begin(); i < r.end(); ++i)
+            if (offset[i] >= 0)
+              std::copy(in_[i]->begin(), in_[i]->end(),
+                        out_[target[i]]->begin() + offset[i]);
+        });
+  };
+  concatenate(in, out);
+  if (var.hasVariances())
+    concatenate(pointers(var.variances<Events>()),
+                pointers(summed.variances<Events>()));
 }
+} // namespace flatten_detail
 
 void flatten_impl(const VariableProxy &summed, const VariableConstProxy &var,
                   const Variable &mask) {
@@ -63,25 +214,27 @@ void flatten_impl(const VariableProxy &summed, const VariableConstProxy &var,
   if (!var.dims().sparse())
     throw except::DimensionError("`flatten` can only be used for sparse data, "
                                  "use `sum` for dense data.");
-  // 1. Reserve space in output. This yields approx. 3x speedup.
-  auto summed_counts = sparse::counts(summed);
-  sum_impl(summed_counts, sparse::counts(var) * ~mask);
-  sparse::reserve(summed, summed_counts);
-
-  // 2. Flatten dimension(s) by concatenating along sparse dim.
-  using namespace flatten_detail;
-  accumulate_in_place<
-      std::tuple<args<double>, args<float>, args<int64_t>, args<int32_t>>>(
-      summed, var, mask,
-      overloaded{
-          [](auto &a, const auto &b, const auto &mask_) {
-            if (!mask_)
-              a.insert(a.end(), b.begin(), b.end());
-          },
-          [](units::Unit &a, const units::Unit &b, const units::Unit &mask_) {
-            expect::equals(mask_, units::dimensionless);
-            expect::equals(a, b);
-          }});
+  if (!summed.dims().sparse())
+    throw except::DimensionError("Cannot flatten the sparse dimension.");
+  expect::equals(mask.unit(), units::dimensionless);
+  expect::equals(summed.unit(), var.unit());
+  if (summed.hasVariances() != var.hasVariances())
+    throw except::VariancesError(
+        "Cannot flatten data with and without variances.");
+  if (summed.dtype() != var.dtype())
+    throw except::TypeError("Cannot flatten item dtypes: ", summed, var);
+  switch (var.dtype()) {
+  case dtype<double>:
+    return flatten_detail::flatten<double>(summed, var, mask);
+  case dtype<float>:
+    return flatten_detail::flatten<float>(summed, var, mask);
+  case dtype<int64_t>:
+    return flatten_detail::flatten<int64_t>(summed, var, mask);
+  case dtype<int32_t>:
+    return flatten_detail::flatten<int32_t>(summed, var, mask);
+  default:
+    throw except::TypeError("Cannot flatten item dtypes: ", summed, var);
+  }
 }
 
 /// Flatten dimension by concatenating along sparse dimension.
@@ -111,10 +264,17 @@ void sum_impl(const VariableProxy &summed, const VariableConstProxy &var) {
   if (var.dims().sparse())
     throw except::DimensionError("`sum` can only be used for dense data, use "
                                  "`flatten` for sparse data.");
-  accumulate_in_place<
-      pair_self_t<double, float, int64_t, int32_t, Eigen::Vector3d>,
-      pair_custom_t<std::pair<int64_t, bool>>>(
-      summed, var, [](auto &&a, auto &&b) { a += b; });
+  reduce_detail::reduce_chunked(
+      summed, var,
+      [](const VariableProxy &out, const VariableConstProxy &in) {
+        accumulate_in_place<
+            pair_self_t<double, float, int64_t, int32_t, Eigen::Vector3d>,
+            pair_custom_t<std::pair<int64_t, bool>>>(
+            out, in, [](auto &&a, auto &&b) { a += b; });
+      },
+      [](const VariableConstProxy &out) {
+        return reduce_detail::make_zeros(out, out.dims());
+      });
 }
 
 Variable sum(const VariableConstProxy &var, const Dim dim) {
@@ -124,7 +284,7 @@ Variable sum(const VariableConstProxy &var, const Dim dim) {
   // Instead the sum is stored in a int64_t Variable
   Variable summed{var.dtype() == DType::Bool
                       ? makeVariable<int64_t>(Dimensions(dims))
-                      : Variable(var, dims)};
+                      : reduce_detail::make_zeros(var, dims)};
   sum_impl(summed, var);
   return summed;
 }
@@ -233,10 +393,19 @@ VariableProxy mean(const VariableConstProxy &var, const Dim dim,
   return mean(var, dim, out);
 }
 
+/// Reduce using an idempotent operation, see reduce_idempotent.
+///
+/// Since op(a,a) = a, partial results of a parallel reduction can be
+/// initialized with a copy of the output.
 template <class Op>
 void reduce_impl(const VariableProxy &out, const VariableConstProxy &var) {
   expect::notSparse(var);
-  accumulate_in_place(out, var, Op{});
+  reduce_detail::reduce_chunked(
+      out, var,
+      [](const VariableProxy &out_, const VariableConstProxy &in) {
+        accumulate_in_place(out_, in, Op{});
+      },
+      [](const VariableConstProxy &out_) { return Variable(out_); });
 }
 
 /// Reduction for idempotent operations such that op(a,a) = a.
@@ -30,116 +30,155 @@ const auto tofToEnergyPhysicalConstants =
     0.5 * boost::units::si::constants::codata::m_n * J_to_meV /
     (tof_to_s * tof_to_s);
 
-template <class T>
-static T convert_with_factor(T &&d, const Dim from, const Dim to,
-                             const Variable &factor) {
+namespace convert_detail {
+/// Physical constant split into value and unit, for use in transform
+/// operations that also handle units.
+struct Constant {
+  double value;
+  units::Unit unit;
+};
+template <class T> Constant constant(const boost::units::quantity<T> &q) {
+  return {q.value(), units::Unit(T{})};
+}
+
+template <class T> bool has_sample(const T &d) {
+  return d.labels().contains("sample_position") ||
+         d.attrs().contains("sample_position");
+}
+
+/// Return `op(L)` for the flight path length L of every spectrum.
+///
+/// L is computed from the positions on the fly, in a single pass without
+/// temporaries for l1, l2, or difference vectors. As in flight_path_length, L
+/// is the straight distance from the source if there is no sample.
+template <class T, class Op> Variable flight_path_transform(const T &d, Op op) {
+  if (has_sample(d))
+    return transform<std::tuple<std::tuple<Eigen::Vector3d, Eigen::Vector3d,
+                                           Eigen::Vector3d>>>(
+        position(d), sample_position(d), source_position(d),
+        overloaded{
+            [op](const auto &pos, const auto &sample, const auto &source) {
+              return op((sample - source).norm() + (pos - sample).norm());
+            },
+            [op](const units::Unit &pos, const units::Unit &sample,
+                 const units::Unit &source) {
+              return op((sample - source) + (pos - sample));
+            }});
+  return transform<pair_self_t<Eigen::Vector3d>>(
+      position(d), source_position(d),
+      overloaded{[op](const auto &pos, const auto &source) {
+                   return op((pos - source).norm());
+                 },
+                 [op](const units::Unit &pos, const units::Unit &source) {
+                   return op(pos - source);
+                 }});
+}
+
+/// Apply `op(coord, factor)` to the dense and sparse coords for `from` and
+/// rename `from` to `to`.
+///
+/// `factor` holds the per-spectrum conversion factor. The conversion of each
+/// coord is a single (parallel) pass over its elements, i.e., events are
+/// touched exactly once. `op` must also handle units.
+template <class T, class Op>
+T convert_coords(T &&d, const Dim from, const Dim to, const Variable &factor,
+                 Op op) {
   // 1. Transform coordinate
-  // Cannot use *= since often a broadcast into Dim::Spectrum is required.
+  // Cannot transform in place since often a broadcast into Dim::Spectrum is
+  // required.
   if (d.coords().contains(from) && !d.coords()[from].dims().sparse()) {
-    const auto &coords = d.coords()[from];
-    d.setCoord(from, coords * astype(factor, coords.dtype()));
+    const auto &coord = d.coords()[from];
+    d.setCoord(from, transform<pair_self_t<double, float>>(
+                         coord, astype(factor, coord.dtype()), op));
   }
 
   // 2. Transform sparse coordinates
   for (const auto &data : iter(d)) {
-    if (data.dims().sparse()) {
-      data.coords()[from] *= factor;
+    if (data.coords()[from].dims().sparse()) {
+      transform_in_place<pair_self_t<double, float>>(
+          data.coords()[from], factor,
+          [op](auto &coord_, const auto &factor_) {
+            coord_ = op(coord_, factor_);
+          });
     }
   }
   d.rename(from, to);
   return std::move(d);
 }
 
-template <class T> auto tofToDSpacing(const T &d) {
-  const auto &sourcePos = source_position(d);
-  const auto &samplePos = sample_position(d);
-
-  auto beam = samplePos - sourcePos;
-  const auto l1 = norm(beam);
-  beam /= l1;
-  auto scattered = neutron::position(d) - samplePos;
-  const auto l2 = norm(scattered);
-  scattered /= l2;
-
-  // l_total = l1 + l2
-  auto conversionFactor(l1 + l2);
-
-  conversionFactor *= 2.0 * boost::units::si::constants::codata::m_n /
-                      boost::units::si::constants::codata::h /
-                      (m_to_angstrom * tof_to_s);
-  conversionFactor *= sqrt(0.5 * (1.0 - dot(beam, scattered)));
-
-  return reciprocal(conversionFactor);
+static constexpr auto times = [](const auto &coord, const auto &factor) {
+  return coord * factor;
+};
+} // namespace convert_detail
+
+/// Return the factor converting time-of-flight into d-spacing, or the inverse.
+///
+/// l1, l2, and the scattering angle are computed in the same pass.
+template <bool inverse = false, class T> auto tofToDSpacing(const T &d) {
+  using namespace convert_detail;
+  const auto c = constant(2.0 * boost::units::si::constants::codata::m_n /
+                          boost::units::si::constants::codata::h /
+                          (m_to_angstrom * tof_to_s));
+  return transform<
+      std::tuple<std::tuple<Eigen::Vector3d, Eigen::Vector3d, Eigen::Vector3d>>>(
+      neutron::position(d), sample_position(d), source_position(d),
+      overloaded{
+          [c](const auto &pos, const auto &sample, const auto &source) {
+            const Eigen::Vector3d beam = sample - source;
+            const Eigen::Vector3d scattered = pos - sample;
+            const auto l1 = beam.norm();
+            const auto l2 = scattered.norm();
+            const auto factor =
+                c.value * (l1 + l2) *
+                std::sqrt(0.5 * (1.0 - beam.dot(scattered) / (l1 * l2)));
+            return inverse ? factor : 1.0 / factor;
+          },
+          [c](const units::Unit &pos, const units::Unit &sample,
+              const units::Unit &source) {
+            const auto factor = c.unit * ((sample - source) + (pos - sample));
+            return inverse ? factor : units::Unit(units::dimensionless) / factor;
+          }});
 }
 
-template <class T> static auto tofToWavelength(const T &d) {
-  return (tof_to_s * m_to_angstrom * boost::units::si::constants::codata::h /
-          boost::units::si::constants::codata::m_n) /
-         neutron::flight_path_length(d);
+template <bool inverse = false, class T>
+static auto tofToWavelength(const T &d) {
+  const auto c = convert_detail::constant(
+      tof_to_s * m_to_angstrom * boost::units::si::constants::codata::h /
+      boost::units::si::constants::codata::m_n);
+  return convert_detail::flight_path_transform(
+      d, overloaded{[c](const double l) {
+                      return inverse ? l / c.value : c.value / l;
+                    },
+                    [c](const units::Unit &l) {
+                      return inverse ? l / c.unit : c.unit / l;
+                    }});
 }
 
 template <class T> auto tofToEnergyConversionFactor(const T &d) {
-  // l_total = l1 + l2
-  auto conversionFactor = neutron::flight_path_length(d);
-  // l_total^2
-  conversionFactor *= conversionFactor;
-
-  conversionFactor *= tofToEnergyPhysicalConstants;
-
-  return conversionFactor;
+  // l_total^2 * constants
+  const auto c = convert_detail::constant(tofToEnergyPhysicalConstants);
+  return convert_detail::flight_path_transform(
+      d, overloaded{[c](const double l) { return c.value * l * l; },
+                    [c](const units::Unit &l) { return c.unit * l * l; }});
 }
 
 template <class T> T tofToEnergy(T &&d) {
-  // 1. Compute conversion factor
   const auto conversionFactor = tofToEnergyConversionFactor(d);
-
-  // 2. Transform coordinate
-  if (d.coords().contains(Dim::Tof) && !d.coords()[Dim::Tof].dims().sparse()) {
-    const auto &coordSq = d.coords()[Dim::Tof] * d.coords()[Dim::Tof];
-    d.setCoord(Dim::Tof, (reciprocal(coordSq) *
-                          astype(conversionFactor, coordSq.dtype())));
-  }
-
-  // 3. Transform sparse coordinates
-  for (const auto &data : iter(d)) {
-    if (data.coords()[Dim::Tof].dims().sparse()) {
-      transform_in_place<pair_self_t<double, float>>(
-          data.coords()[Dim::Tof], conversionFactor,
-          [](auto &coord_, const auto &factor) {
-            coord_ = factor / (coord_ * coord_);
-          });
-    }
-  }
-
-  d.rename(Dim::Tof, Dim::Energy);
-  return std::move(d);
+  return convert_detail::convert_coords(
+      std::forward<T>(d), Dim::Tof, Dim::Energy, conversionFactor,
+      [](const auto &tof, const auto &factor) {
+        return factor / (tof * tof);
+      });
 }
 
 template <class T> T energyToTof(T &&d) {
-  // 1. Compute conversion factor
   const auto conversionFactor = tofToEnergyConversionFactor(d);
-
-  // 2. Transform coordinate
-  if (d.coords().contains(Dim::Energy) &&
-      !d.coords()[Dim::Energy].dims().sparse()) {
-    const auto &coordSqrt = d.coords()[Dim::Energy];
-    d.setCoord(Dim::Energy,
-               sqrt(astype(conversionFactor, coordSqrt.dtype()) / coordSqrt));
-  }
-
-  // 3. Transform sparse coordinates
-  for (const auto &data : iter(d)) {
-    if (data.coords()[Dim::Energy].dims().sparse()) {
-      transform_in_place<pair_self_t<double, float>>(
-          data.coords()[Dim::Energy], conversionFactor,
-          [](auto &coord_, const auto &factor) {
-            coord_ = sqrt(factor / coord_);
-          });
-    }
-  }
-
-  d.rename(Dim::Energy, Dim::Tof);
-  return std::move(d);
+  return convert_detail::convert_coords(
+      std::forward<T>(d), Dim::Energy, Dim::Tof, conversionFactor,
+      [](const auto &energy, const auto &factor) {
+        using std::sqrt;
+        return sqrt(factor / energy);
+      });
 }
 
 /*
@@ -218,17 +257,19 @@ template <class T> T convert_impl(T d, const Dim from, const Dim to) {
   for (const auto &item : iter(d))
     if (item.hasData())
       expect::notCountDensity(item.unit());
+  using convert_detail::convert_coords;
+  using convert_detail::times;
   if ((from == Dim::Tof) && (to == Dim::DSpacing))
-    return convert_with_factor(std::move(d), from, to, tofToDSpacing(d));
+    return convert_coords(std::move(d), from, to, tofToDSpacing(d), times);
   if ((from == Dim::DSpacing) && (to == Dim::Tof))
-    return convert_with_factor(std::move(d), from, to,
-                               reciprocal(tofToDSpacing(d)));
+    return convert_coords(std::move(d), from, to, tofToDSpacing<true>(d),
+                          times);
 
   if ((from == Dim::Tof) && (to == Dim::Wavelength))
-    return convert_with_factor(std::move(d), from, to, tofToWavelength(d));
+    return convert_coords(std::move(d), from, to, tofToWavelength(d), times);
   if ((from == Dim::Wavelength) && (to == Dim::Tof))
-    return convert_with_factor(std::move(d), from, to,
-                               reciprocal(tofToWavelength(d)));
+    return convert_coords(std::move(d), from, to, tofToWavelength<true>(d),
+                          times);
 
   if ((from == Dim::Tof) && (to == Dim::Energy))
     return tofToEnergy(std::move(d));
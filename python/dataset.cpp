@@ -478,6 +478,38 @@ void init_dataset(py::module &m) {
         :return: Histogramed data.
         :rtype: Dataset)");
 
+  m.def("filter_events",
+        [](const DataProxy &x, const Dim dim, const VariableConstProxy &min,
+           const VariableConstProxy &max) {
+          core::filter_events(x, dim, min, max);
+        },
+        py::arg("x"), py::arg("dim"), py::arg("min"), py::arg("max"),
+        py::call_guard<py::gil_scoped_release>(),
+        R"(Remove events with a sparse coord outside the interval [min, max), in place.
+
+        The sparse coord, data, and sparse labels are filtered together.
+
+        :param x: Data that is sparse in `dim`.
+        :param dim: Sparse dimension whose coord is used for filtering.
+        :param min: Lower bound (inclusive), a scalar with dtype and unit of the coord.
+        :param max: Upper bound (exclusive), a scalar with dtype and unit of the coord.
+        :raises: If `x` is not sparse in `dim`, or if the dtype or unit of the bounds does not match the coord.)");
+
+  m.def("filter_events",
+        [](Dataset &x, const Dim dim, const VariableConstProxy &min,
+           const VariableConstProxy &max) {
+          core::filter_events(x, dim, min, max);
+        },
+        py::arg("x"), py::arg("dim"), py::arg("min"), py::arg("max"),
+        py::call_guard<py::gil_scoped_release>(),
+        R"(Remove events with a sparse coord outside the interval [min, max) from all items that are sparse in `dim`, in place.
+
+        :param x: Dataset to filter.
+        :param dim: Sparse dimension whose coord is used for filtering.
+        :param min: Lower bound (inclusive), a scalar with dtype and unit of the coord.
+        :param max: Upper bound (exclusive), a scalar with dtype and unit of the coord.
+        :raises: If the dtype or unit of the bounds does not match the coords.)");
+
   m.def("merge",
         [](const DatasetConstProxy &lhs, const DatasetConstProxy &rhs) {
           return core::merge(lhs, rhs);
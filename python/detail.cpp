@@ -3,6 +3,8 @@
 /// @file
 /// @author Simon Heybrock
 
+#include "scipp/core/parallel.h"
+
 #include "detail.h"
 #include "pybind11.h"
 
@@ -88,4 +90,21 @@ void init_detail(py::module &m) {
 
       :return: A DataArray.
       :rtype: DataArray)");
+
+  detail.def("set_max_threads", &parallel::set_max_threads, py::arg("n"),
+             R"(Set the maximum number of threads used by parallel operations.
+
+      A value of 0 selects the number of hardware threads.)");
+
+  detail.def("max_threads", &parallel::max_threads,
+             R"(Return the maximum number of threads used by parallel
+      operations.)");
+
+  detail.def("set_grainsize", &parallel::set_grainsize, py::arg("grainsize"),
+             R"(Set the minimum number of elements processed by a single task
+      of a parallel operation. Smaller inputs are processed serially.)");
+
+  detail.def("grainsize", &parallel::grainsize,
+             R"(Return the minimum number of elements processed by a single
+      task of a parallel operation.)");
 }
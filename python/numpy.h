@@ -5,6 +5,11 @@
 #ifndef SCIPPY_NUMPY_H
 #define SCIPPY_NUMPY_H
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "scipp/core/element_array.h"
 #include "scipp/core/variable.h"
 
 #include "pybind11.h"
@@ -13,71 +18,60 @@ namespace py = pybind11;
 using namespace scipp;
 using namespace scipp::core;
 
-template <class T, class Proxy>
-void copy_flattened_0d(const py::array_t<T> &data, Proxy &&proxy) {
-  auto r = data.unchecked();
-  auto it = proxy.begin();
-  *it = r();
-}
-
-template <class T, class Proxy>
-void copy_flattened_1d(const py::array_t<T> &data, Proxy &&proxy) {
-  auto r = data.unchecked();
-  auto it = proxy.begin();
-  for (ssize_t i = 0; i < r.shape(0); ++i, ++it)
-    *it = r(i);
-}
-
-template <class T, class Proxy>
-void copy_flattened_2d(const py::array_t<T> &data, Proxy &&proxy) {
-  auto r = data.unchecked();
-  auto it = proxy.begin();
-  for (ssize_t i = 0; i < r.shape(0); ++i)
-    for (ssize_t j = 0; j < r.shape(1); ++j, ++it)
-      *it = r(i, j);
-}
-
-template <class T, class Proxy>
-void copy_flattened_3d(const py::array_t<T> &data, Proxy &&proxy) {
-  auto r = data.unchecked();
-  auto it = proxy.begin();
-  for (ssize_t i = 0; i < r.shape(0); ++i)
-    for (ssize_t j = 0; j < r.shape(1); ++j)
-      for (ssize_t k = 0; k < r.shape(2); ++k, ++it)
-        *it = r(i, j, k);
-}
-
-template <class T, class Proxy>
-void copy_flattened_4d(const py::array_t<T> &data, Proxy &&proxy) {
-  auto r = data.unchecked();
-  auto it = proxy.begin();
-  for (ssize_t i = 0; i < r.shape(0); ++i)
-    for (ssize_t j = 0; j < r.shape(1); ++j)
-      for (ssize_t k = 0; k < r.shape(2); ++k)
-        for (ssize_t l = 0; l < r.shape(3); ++l, ++it)
-          *it = r(i, j, k, l);
-}
-
+/// Copy the elements of a numpy array of any dimensionality to `proxy`, in
+/// row-major order.
 template <class T, class Proxy>
 void copy_flattened(const py::array_t<T> &data, Proxy &&proxy) {
   if (scipp::size(proxy) != data.size())
     throw std::runtime_error(
         "Numpy data size does not match size of target object.");
-  switch (data.ndim()) {
-  case 0:
-    return copy_flattened_0d(data, proxy);
-  case 1:
-    return copy_flattened_1d(data, proxy);
-  case 2:
-    return copy_flattened_2d(data, proxy);
-  case 3:
-    return copy_flattened_3d(data, proxy);
-  case 4:
-    return copy_flattened_4d(data, proxy);
-  default:
-    throw std::runtime_error("Numpy array has more dimensions than supported "
-                             "in the current implementation.");
+  if (data.size() == 0)
+    return;
+  auto it = proxy.begin();
+  if (data.flags() & py::array::c_style) {
+    std::copy(data.data(), data.data() + data.size(), it);
+    return;
+  }
+  // Generic strided copy, with a contiguous loop over the innermost dimension.
+  const auto ndim = data.ndim();
+  const auto inner = data.shape(ndim - 1);
+  const auto stride = data.strides(ndim - 1);
+  const auto *base = reinterpret_cast<const char *>(data.data());
+  std::vector<ssize_t> index(ndim - 1, 0);
+  for (ssize_t outer = 0; outer < data.size() / inner; ++outer) {
+    const char *row = base;
+    for (ssize_t d = 0; d < ndim - 1; ++d)
+      row += index[d] * data.strides(d);
+    for (ssize_t i = 0; i < inner; ++i, ++it)
+      *it = *reinterpret_cast<const T *>(row + i * stride);
+    for (ssize_t d = ndim - 2; d >= 0; --d) {
+      if (++index[d] < data.shape(d))
+        break;
+      index[d] = 0;
+    }
   }
 }
 
+/// Return true if the buffer of `data` can be referenced by a variable with
+/// element type T without copying.
+template <class T> bool can_adopt(const py::array &data) {
+  return py::isinstance<py::array_t<T, py::array::c_style>>(data) &&
+         data.writeable() && data.size() != 0;
+}
+
+/// Return element_array referencing the buffer of `data`, keeping `data`
+/// alive as long as the buffer is in use.
+template <class T> auto adopt_buffer(py::array data) {
+  auto *ptr = static_cast<T *>(data.mutable_data());
+  const auto size = data.size();
+  std::shared_ptr<void> owner(data.release().ptr(), [](void *obj) {
+    // The last reference may be dropped in a thread without GIL.
+    if (!Py_IsInitialized())
+      return;
+    py::gil_scoped_acquire acquire;
+    Py_DECREF(static_cast<PyObject *>(obj));
+  });
+  return scipp::core::detail::element_array<T>(ptr, size, std::move(owner));
+}
+
 #endif // SCIPPY_NUMPY_H
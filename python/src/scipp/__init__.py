@@ -13,6 +13,8 @@ del runtime_config
 from ._scipp.core import *
 from ._scipp import __version__
 from . import detail
+detail.set_max_threads(config.parallel.max_threads)
+detail.set_grainsize(config.parallel.grainsize)
 from . import neutron
 from .show import show, make_svg
 from .table import table
@@ -85,6 +85,13 @@ defaults = {
         "hover": "#d6eaf8",
     },
     "table_max_size": 50,
+    # Settings for multi-threading in the C++ core
+    "parallel": {
+        # Maximum number of threads, 0 selects the number of hardware threads
+        "max_threads": 0,
+        # Minimum number of elements processed by a single task
+        "grainsize": 10000,
+    },
 }
 
 config_directory = appdirs.user_config_dir('scipp')
@@ -0,0 +1,31 @@
+# SPDX-License-Identifier: GPL-3.0-or-later
+# Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+# @file
+# @author Simon Heybrock
+import scipp as sc
+from scipp import Dim
+import numpy as np
+
+
+def test_max_threads():
+    previous = sc.detail.max_threads()
+    sc.detail.set_max_threads(2)
+    assert sc.detail.max_threads() == 2
+    sc.detail.set_max_threads(previous)
+
+
+def test_grainsize():
+    previous = sc.detail.grainsize()
+    sc.detail.set_grainsize(100)
+    assert sc.detail.grainsize() == 100
+    sc.detail.set_grainsize(previous)
+
+
+def test_result_independent_of_max_threads():
+    previous = sc.detail.max_threads()
+    var = sc.Variable([Dim.X], values=np.arange(100000.0))
+    sc.detail.set_max_threads(1)
+    expected = var * var
+    sc.detail.set_max_threads(4)
+    assert (var * var) == expected
+    sc.detail.set_max_threads(previous)
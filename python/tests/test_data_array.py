@@ -114,3 +114,21 @@ def test_reciprocal():
     a = sc.DataArray(data=sc.Variable([Dim.X], values=np.array([5.0])))
     r = sc.reciprocal(a)
     assert r.values[0] == 1.0 / 5.0
+
+
+def test_filter_events():
+    coord = sc.sparse_from_flat([Dim.Y, Dim.X],
+                                counts=np.array([3, 1]),
+                                values=np.array([1.0, 5.0, 3.0, 7.0]),
+                                unit=sc.units.us)
+    data = sc.sparse_from_flat([Dim.Y, Dim.X],
+                               counts=np.array([3, 1]),
+                               values=np.array([1.0, 2.0, 3.0, 4.0]),
+                               variances=np.array([5.0, 6.0, 7.0, 8.0]),
+                               unit=sc.units.counts)
+    a = sc.DataArray(data=data, coords={Dim.X: coord})
+    sc.filter_events(a, Dim.X, 2.0 * sc.units.us, 6.0 * sc.units.us)
+    assert np.array_equal(a.coords[Dim.X][Dim.Y, 0].values, [5.0, 3.0])
+    assert len(a.coords[Dim.X][Dim.Y, 1].values) == 0
+    assert np.array_equal(a[Dim.Y, 0].values, [2.0, 3.0])
+    assert np.array_equal(a[Dim.Y, 0].variances, [6.0, 7.0])
@@ -88,6 +88,50 @@ def test_create_with_variances_from_numpy_1d():
     np.testing.assert_array_equal(var.variances, np.arange(4, 8))
 
 
+def test_create_from_numpy_copies_by_default():
+    values = np.arange(4.0)
+    var = sc.Variable([sc.Dim.X], values=values)
+    values[0] = 10.0
+    assert var.values[0] == 0.0
+
+
+def test_create_from_numpy_without_copy():
+    values = np.arange(4.0)
+    variances = np.arange(4.0, 8.0)
+    var = sc.Variable([sc.Dim.X],
+                      values=values,
+                      variances=variances,
+                      copy=False)
+    values[0] = 10.0
+    variances[0] = 20.0
+    del values
+    del variances
+    np.testing.assert_array_equal(var.values, [10, 1, 2, 3])
+    np.testing.assert_array_equal(var.variances, [20, 5, 6, 7])
+
+
+def test_create_from_numpy_without_copy_converts_if_required():
+    values = np.arange(4)
+    var = sc.Variable([sc.Dim.X],
+                      values=values,
+                      dtype=sc.dtype.float64,
+                      copy=False)
+    values[0] = 10
+    assert var.values[0] == 0.0
+
+
+def test_create_from_numpy_5d():
+    values = np.arange(32.0).reshape(2, 2, 2, 2, 2)
+    var = sc.Variable([Dim.X, Dim.Y, Dim.Z, Dim.Row, Dim.Time], values)
+    np.testing.assert_array_equal(var.values, values)
+
+
+def test_create_from_numpy_non_contiguous():
+    values = np.arange(24.0).reshape(2, 3, 4)[:, ::2, 1:]
+    var = sc.Variable([Dim.X, Dim.Y, Dim.Z], values)
+    np.testing.assert_array_equal(var.values, values)
+
+
 def test_create_scalar():
     var = sc.Variable(1.2)
     assert var.value == 1.2
@@ -325,6 +369,67 @@ def test_sparse_setitem_int64_t():
     assert len(var[Dim.X, 0].values) == 4
 
 
+def test_sparse_from_flat():
+    var = sc.sparse_from_flat([Dim.X, Dim.Y],
+                              counts=np.array([2, 0, 3]),
+                              values=np.arange(5.0),
+                              variances=np.arange(5.0, 10.0),
+                              unit=sc.units.us)
+    assert var.dims == [Dim.X]
+    assert var.sparse_dim == Dim.Y
+    assert var.unit == sc.units.us
+    assert np.array_equal(var[Dim.X, 0].values, [0.0, 1.0])
+    assert len(var[Dim.X, 1].values) == 0
+    assert np.array_equal(var[Dim.X, 2].values, [2.0, 3.0, 4.0])
+    assert np.array_equal(var[Dim.X, 2].variances, [7.0, 8.0, 9.0])
+
+
+def test_sparse_from_flat_2d_dtype():
+    var = sc.sparse_from_flat([Dim.X, Dim.Z, Dim.Y],
+                              counts=np.array([[1, 0], [0, 2]]),
+                              values=np.arange(3),
+                              dtype=sc.dtype.float32)
+    assert var.dtype == sc.dtype.float32
+    assert var.shape == [2, 2, None]
+    assert np.array_equal(var[Dim.X, 1][Dim.Z, 1].values, [1.0, 2.0])
+    assert var.variances is None
+
+
+def test_sparse_from_flat_size_fail():
+    with pytest.raises(RuntimeError):
+        sc.sparse_from_flat([Dim.X, Dim.Y],
+                            counts=np.array([2, 2]),
+                            values=np.arange(3.0))
+    with pytest.raises(RuntimeError):
+        sc.sparse_from_flat([Dim.X],
+                            counts=np.array([2, 1]),
+                            values=np.arange(3.0))
+
+
+def test_sparse_to_flat():
+    var = sc.sparse_from_flat([Dim.X, Dim.Y],
+                              counts=np.array([2, 0, 3]),
+                              values=np.arange(5.0),
+                              variances=np.arange(5.0, 10.0))
+    counts, values, variances = sc.sparse_to_flat(var)
+    assert np.array_equal(counts, [2, 0, 3])
+    assert np.array_equal(values, np.arange(5.0))
+    assert np.array_equal(variances, np.arange(5.0, 10.0))
+    assert sc.sparse_from_flat([Dim.X, Dim.Y],
+                               counts=counts,
+                               values=values,
+                               variances=variances) == var
+
+
+def test_sparse_to_flat_without_variances():
+    var = sc.Variable([Dim.X, Dim.Y], [2, sc.Dimensions.Sparse])
+    var[Dim.X, 1].values = np.arange(2)
+    counts, values, variances = sc.sparse_to_flat(var)
+    assert np.array_equal(counts, [0, 2])
+    assert np.array_equal(values, [0, 1])
+    assert variances is None
+
+
 def test_create_dtype():
     var = sc.Variable([Dim.X], values=np.arange(4).astype(np.int64))
     assert var.dtype == sc.dtype.int64
@@ -3,11 +3,14 @@
 /// @file
 /// @author Simon Heybrock
 
+#include <numeric>
+
 #include "scipp/units/unit.h"
 
 #include "scipp/core/dataset.h"
 #include "scipp/core/dtype.h"
 #include "scipp/core/except.h"
+#include "scipp/core/packed_sparse.h"
 #include "scipp/core/sort.h"
 #include "scipp/core/tag_util.h"
 #include "scipp/core/transform.h"
@@ -30,21 +33,35 @@ namespace py = pybind11;
 template <class T> struct MakeVariable {
   static Variable apply(const std::vector<Dim> &labels, py::array values,
                         const std::optional<py::array> &variances,
-                        const units::Unit unit) {
+                        const units::Unit unit, const bool copy) {
     // Pybind11 converts py::array to py::array_t for us, with all sorts of
     // automatic conversions such as integer to double, if required.
     py::array_t<T> valuesT(values);
     py::buffer_info info = valuesT.request();
     Dimensions dims(labels, {info.shape.begin(), info.shape.end()});
+    if (!copy && can_adopt<T>(values) &&
+        (!variances || can_adopt<T>(*variances))) {
+      if (!variances)
+        return Variable(unit, dims, adopt_buffer<T>(values));
+      expect::equals(dims, Dimensions(labels, {variances->shape(),
+                                               variances->shape() +
+                                                   variances->ndim()}));
+      return Variable(unit, dims, adopt_buffer<T>(values),
+                      adopt_buffer<T>(*variances));
+    }
     auto var = variances
                    ? makeVariable<T>(Dimensions{dims}, Values{}, Variances{})
                    : makeVariable<T>(Dimensions(dims));
-    copy_flattened<T>(valuesT, var.template values<T>());
+    {
+      py::gil_scoped_release release;
+      copy_flattened<T>(valuesT, var.template values<T>());
+    }
     if (variances) {
       py::array_t<T> variancesT(*variances);
       info = variancesT.request();
       expect::equals(
           dims, Dimensions(labels, {info.shape.begin(), info.shape.end()}));
+      py::gil_scoped_release release;
       copy_flattened<T>(variancesT, var.template variances<T>());
     }
     var.setUnit(unit);
@@ -65,6 +82,58 @@ template <class T> struct MakeVariableDefaultInit {
   }
 };
 
+template <class T> struct MakeSparseFromFlat {
+  static Variable apply(const std::vector<Dim> &labels,
+                        const py::array_t<scipp::index> &counts,
+                        py::array values,
+                        const std::optional<py::array> &variances,
+                        const units::Unit unit) {
+    std::vector<scipp::index> shape(counts.shape(),
+                                    counts.shape() + counts.ndim());
+    shape.push_back(Dimensions::Sparse);
+    Dimensions dims(labels, shape);
+    std::vector<scipp::index> offsets(counts.size() + 1, 0);
+    copy_flattened<scipp::index>(counts,
+                                 scipp::span(offsets).subspan(1));
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    // Reference the event buffers if possible, unpacking copies them anyway.
+    auto buffer = MakeVariable<T>::apply({dims.sparseDim()}, values,
+                                         variances, unit, false);
+    py::gil_scoped_release release;
+    return PackedSparse(dims, std::move(offsets), std::move(buffer)).unpack();
+  }
+};
+
+template <class T> struct SparseToFlat {
+  static py::tuple apply(const VariableConstProxy &var) {
+    std::unique_ptr<PackedSparse> packed;
+    {
+      py::gil_scoped_release release;
+      packed = std::make_unique<PackedSparse>(var);
+    }
+    const auto offsets = packed->offsets();
+    const auto shape = packed->dims().shape();
+    py::array_t<scipp::index> counts(
+        std::vector<ssize_t>(shape.begin(), shape.end()));
+    std::adjacent_difference(offsets.begin() + 1, offsets.end(),
+                             counts.mutable_data());
+    // The event arrays reference the buffer of `packed`, which is deleted
+    // once both arrays are gone.
+    auto buffer = packed->buffer();
+    const py::capsule owner(packed.release(), [](void *ptr) {
+      delete static_cast<PackedSparse *>(ptr);
+    });
+    const auto size = static_cast<ssize_t>(buffer.dims().volume());
+    py::array values(py::dtype::of<T>(), {size}, {sizeof(T)},
+                     buffer.values<T>().data(), owner);
+    py::object variances = py::none();
+    if (buffer.hasVariances())
+      variances = py::array(py::dtype::of<T>(), {size}, {sizeof(T)},
+                            buffer.variances<T>().data(), owner);
+    return py::make_tuple(counts, values, variances);
+  }
+};
+
 template <class ST> struct MakeODFromNativePythonTypes {
   template <class T> struct Maker {
     static Variable apply(const units::Unit unit, const ST &value,
@@ -113,7 +182,8 @@ auto do_init_0D(const T &value, const std::optional<T> &variance,
 
 Variable doMakeVariable(const std::vector<Dim> &labels, py::array &values,
                         std::optional<py::array> &variances,
-                        const units::Unit unit, const py::object &dtype) {
+                        const units::Unit unit, const py::object &dtype,
+                        const bool copy = true) {
   // Use custom dtype, otherwise dtype of data.
   const auto dtypeTag =
       dtype.is_none() ? scipp_dtype(values.dtype()) : scipp_dtype(dtype);
@@ -135,7 +205,7 @@ Variable doMakeVariable(const std::vector<Dim> &labels, py::array &values,
   }
 
   return CallDType<double, float, int64_t, int32_t, bool>::apply<MakeVariable>(
-      dtypeTag, labels, values, variances, unit);
+      dtypeTag, labels, values, variances, unit, copy);
 }
 
 Variable makeVariableDefaultInit(const std::vector<Dim> &labels,
@@ -265,7 +335,7 @@ void init_variable(py::module &m) {
            py::arg("values"), // py::array
            py::arg("variances") = std::nullopt,
            py::arg("unit") = units::Unit(units::dimensionless),
-           py::arg("dtype") = py::none())
+           py::arg("dtype") = py::none(), py::arg("copy") = true)
       .def("rename_dims", &rename_dims<Variable>, py::arg("dims_dict"),
            "Rename dimensions.")
       .def("copy", [](const Variable &self) { return self; },
@@ -358,6 +428,48 @@ void init_variable(py::module &m) {
   py::implicitly_convertible<Variable, VariableConstProxy>();
   py::implicitly_convertible<Variable, VariableProxy>();
 
+  m.def("sparse_from_flat",
+        [](const std::vector<Dim> &labels,
+           const py::array_t<scipp::index> &counts, py::array &values,
+           const std::optional<py::array> &variances, const units::Unit unit,
+           const py::object &dtype) {
+          return CallDType<double, float, int64_t, int32_t>::apply<
+              MakeSparseFromFlat>(dtype.is_none() ? scipp_dtype(values.dtype())
+                                                  : scipp_dtype(dtype),
+                                  labels, counts, values, variances, unit);
+        },
+        py::arg("dims"), py::arg("counts"), py::arg("values"),
+        py::arg("variances") = std::nullopt,
+        py::arg("unit") = units::Unit(units::dimensionless),
+        py::arg("dtype") = py::none(), R"(
+        Make a sparse variable from flat arrays of events.
+
+        The events of all elements are concatenated in `values` (and
+        `variances`), `counts` holds the number of events of each element.
+
+        :param dims: Dimension labels, the last label is the sparse dimension.
+        :param counts: Number of events of each element, its shape defines the shape of the dense dimensions.
+        :param values: 1-D array with the event values of all elements.
+        :param variances: Optional 1-D array with the event variances of all elements.
+        :raises: If the total of `counts` does not match the number of events, or if the number of labels does not match the dimensionality of `counts` plus one.
+        :seealso: :py:class:`scipp.sparse_to_flat`
+        :return: New sparse variable.
+        :rtype: Variable)");
+
+  m.def("sparse_to_flat",
+        [](const VariableConstProxy &self) {
+          return CallDType<double, float, int64_t, int32_t>::apply<
+              SparseToFlat>(self.dtype(), self);
+        },
+        py::arg("x"), R"(
+        Export the events of a sparse variable to flat arrays.
+
+        This is the inverse of :py:class:`scipp.sparse_from_flat`.
+
+        :raises: If the variable is not sparse.
+        :return: Tuple of counts, values and variances. Variances is None if the variable has no variances.
+        :rtype: tuple)");
+
   m.def("reshape",
         [](const VariableProxy &self, const std::vector<Dim> &labels,
            const py::tuple &shape) {